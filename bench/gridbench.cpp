@@ -0,0 +1,150 @@
+// Microbenchmark for per-frame traversal of the map's entity grid
+//
+// Compares a full traversal (every cell, top left -> down right) of the
+// flat entity grid against the unordered_map grid it replaced, on the
+// shipped maps and on synthetic 256x256 maps.
+//
+// usage: gridbench [maps directory]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "level/level.hpp"
+#include "entities/boost.hpp"
+#include "entities/diamond.hpp"
+#include "entities/receptor.hpp"
+
+namespace fs = std::filesystem;
+
+// keep traversal results alive so the loops aren't optimized away
+static volatile long long sink = 0;
+
+// run a traversal for frameCount frames, returns avg. ns per frame
+template <class F>
+double timeFrames(int frameCount, F traverse) {
+    auto start = std::chrono::steady_clock::now();
+
+    for(int frame = 0; frame < frameCount; frame++) {
+        sink = sink + traverse();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / frameCount;
+}
+
+// benchmark both grid representations for a single map
+void benchMap(const std::string & label, const Map & map, int frameCount) {
+    int width = map.getWidth();
+    int height = map.getHeight();
+    auto & entities = map.getEntities();
+
+    // the previous representation: key = index, value = ptr (every cell filled)
+    std::unordered_map<int, std::shared_ptr<Entity>> oldGrid;
+    for(int y = 0; y < height; y++) {
+        for(int x = 0; x < width; x++) {
+            int entityID = map.getGridEntityID(x, y);
+            oldGrid[map.xyToIndex(x, y)] =
+                entityID == Map::NO_ENTITY ? nullptr : entities[entityID];
+        }
+    }
+
+    double oldNs = timeFrames(frameCount, [&]() {
+        long long sum = 0;
+        for(int y = 0; y < height; y++) {
+            for(int x = 0; x < width; x++) {
+                int currIdx = map.xyToIndex(x, y);
+                if(oldGrid.at(currIdx)) {
+                    sum += oldGrid.at(currIdx)->getGridX();
+                }
+            }
+        }
+        return sum;
+    });
+
+    double flatNs = timeFrames(frameCount, [&]() {
+        long long sum = 0;
+        for(int y = 0; y < height; y++) {
+            for(int x = 0; x < width; x++) {
+                int entityID = map.getGridEntityID(x, y);
+                if(entityID != Map::NO_ENTITY) {
+                    sum += entities[entityID]->getGridX();
+                }
+            }
+        }
+        return sum;
+    });
+
+    printf("%-24s %4dx%-4d %7zu %14.1f %14.1f %8.2fx\n", label.c_str(), width,
+        height, entities.size(), oldNs, flatNs, oldNs / flatNs);
+}
+
+// fill a map with randomly placed entities at the given density
+void makeSyntheticMap(Map & map, int width, int height, float density, unsigned int seed) {
+    map.initMap(width, height, 32, 32);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> chance(0.f, 1.f);
+
+    for(int y = 0; y < height; y++) {
+        for(int x = 0; x < width; x++) {
+            map.setTileParity(x, y, chance(rng) < 0.5f ? PARITY_GRAY : PARITY_PURPLE);
+
+            if(chance(rng) >= density) continue;
+
+            std::shared_ptr<Entity> entity;
+            switch(rng() % 3) {
+                case 0:     entity = std::make_shared<Diamond>(x, y, PARITY_GRAY);
+                            break;
+                case 1:     entity = std::make_shared<Boost>(x, y, PARITY_GRAY, 1, DIR_UP);
+                            break;
+                default:    entity = std::make_shared<Receptor>(x, y, PARITY_PURPLE, "diamond");
+                            break;
+            }
+
+            map.addEntity(entity);
+        }
+    }
+}
+
+int main(int argc, char * argv[]) {
+    std::string mapsDir = argc > 1 ? argv[1] : "res/maps";
+
+    const int SHIPPED_FRAMES = 200000;
+    const int SYNTHETIC_FRAMES = 500;
+
+    printf("%-24s %9s %7s %14s %14s %9s\n", "map", "size", "ents",
+        "unordered ns", "flat ns", "speedup");
+
+    // shipped maps
+    std::vector<std::string> mapPaths;
+    for(auto & entry: fs::directory_iterator(mapsDir)) {
+        if(entry.path().extension() == ".tmx") {
+            mapPaths.push_back(entry.path().string());
+        }
+    }
+    std::sort(mapPaths.begin(), mapPaths.end());
+
+    for(auto & mapPath: mapPaths) {
+        Level level(mapPath);
+        benchMap(fs::path(mapPath).filename().string(), level.getMap(), SHIPPED_FRAMES);
+    }
+
+    // synthetic maps at increasing entity densities
+    for(float density: {0.05f, 0.15f, 0.5f}) {
+        Map map;
+        makeSyntheticMap(map, 256, 256, density, 1234);
+
+        std::string label = "synthetic " + std::to_string((int)(density * 100)) + "%";
+        benchMap(label, map, SYNTHETIC_FRAMES);
+    }
+
+    return 0;
+}
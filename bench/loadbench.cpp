@@ -0,0 +1,88 @@
+// Benchmark for level loading
+//
+// Compares loading each map from its tiledmap (XML + base64 + zlib, then
+// resolving every tile's properties) against loading its compiled level
+// (memory mapped, see level/levelfile.hpp). The maps are compiled to a
+// temporary directory first. Reports the average load time of each in us.
+//
+// usage: loadbench [maps directory]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "level/level.hpp"
+
+namespace fs = std::filesystem;
+
+// keep loaded maps alive so the loads aren't optimized away
+static volatile long long sink = 0;
+
+// average time to load a map from the given path, in us (only the map, a
+// level's other setup is the same either way)
+double timeLoads(const std::string & path, int rounds) {
+    Level owner;
+    auto start = std::chrono::steady_clock::now();
+
+    for(int round = 0; round < rounds; round++) {
+        Map map;
+        map.loadMap(path, &owner);
+        sink = sink + map.getEntities().size();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count() * 1e6 / rounds;
+}
+
+int main(int argc, char * argv[]) {
+    std::string mapsDir = argc > 1 ? argv[1] : "res/maps";
+
+    const int TILED_ROUNDS = 50;
+    const int COMPILED_ROUNDS = 5000;
+
+    fs::path compiledDir = fs::temp_directory_path() / "loadbench";
+    fs::create_directories(compiledDir);
+
+    printf("%-24s %9s %7s %12s %12s %9s\n", "map", "size", "ents",
+        "tmx us", "lvl us", "speedup");
+
+    std::vector<std::string> mapPaths;
+    for(auto & entry: fs::directory_iterator(mapsDir)) {
+        if(entry.path().extension() == ".tmx") {
+            mapPaths.push_back(entry.path().string());
+        }
+    }
+    std::sort(mapPaths.begin(), mapPaths.end());
+
+    double tiledTotal = 0.0, compiledTotal = 0.0;
+
+    for(auto & mapPath: mapPaths) {
+        std::string name = fs::path(mapPath).filename().string();
+        std::string compiledPath = (compiledDir / name).replace_extension(".lvl").string();
+
+        Level level(mapPath);
+        if(!level.getMap().saveCompiledMap(compiledPath)) {
+            printf("%-24s failed to compile\n", name.c_str());
+            continue;
+        }
+
+        double tiledUs = timeLoads(mapPath, TILED_ROUNDS);
+        double compiledUs = timeLoads(compiledPath, COMPILED_ROUNDS);
+        tiledTotal += tiledUs;
+        compiledTotal += compiledUs;
+
+        printf("%-24s %4dx%-4d %7zu %12.1f %12.1f %8.1fx\n", name.c_str(),
+            level.getMap().getWidth(), level.getMap().getHeight(),
+            level.getMap().getEntities().size(), tiledUs, compiledUs, tiledUs / compiledUs);
+    }
+
+    printf("%-24s %17s %12.1f %12.1f %8.1fx\n", "total", "", tiledTotal, compiledTotal,
+        tiledTotal / compiledTotal);
+
+    fs::remove_all(compiledDir);
+
+    return 0;
+}
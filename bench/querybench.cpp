@@ -0,0 +1,165 @@
+// Microbenchmark for typed neighbour queries on the map's entity grid
+//
+// Mimics the probes a player makes each step (diamond, receptor, portal and
+// boost in the move direction) for every cell and direction, comparing the
+// old dynamic_pointer_cast lookup (shared_ptr copy + RTTI) against the
+// kind-tagged grid lookup. Reports queries per second.
+//
+// usage: querybench [maps directory]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "level/level.hpp"
+#include "entities/boost.hpp"
+#include "entities/diamond.hpp"
+#include "entities/player.hpp"
+#include "entities/portal.hpp"
+#include "entities/receptor.hpp"
+
+namespace fs = std::filesystem;
+
+// keep query results alive so the loops aren't optimized away
+static volatile long long sink = 0;
+
+const int DIR_OFFSETS[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+
+// types probed per neighbour
+const int QUERY_TYPES = 4;
+
+// the previous lookup: copy the shared_ptr and dynamic cast it
+template <class T>
+std::shared_ptr<T> oldGetGridElement(const Map & map, int x, int y) {
+    std::shared_ptr<T> gridElement = nullptr;
+    if(map.inBounds(x, y)) {
+        int entityID = map.getGridEntityID(x, y);
+        if(entityID != Map::NO_ENTITY) {
+            gridElement = std::dynamic_pointer_cast<T>(map.getEntities()[entityID]);
+        }
+    }
+
+    return gridElement;
+}
+
+// query every neighbour of every cell for rounds rounds, returns queries per second
+template <class F>
+double timeQueries(const Map & map, int rounds, F query) {
+    int width = map.getWidth();
+    int height = map.getHeight();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(int round = 0; round < rounds; round++) {
+        long long sum = 0;
+        for(int y = 0; y < height; y++) {
+            for(int x = 0; x < width; x++) {
+                for(auto & offset: DIR_OFFSETS) {
+                    sum += query(x + offset[0], y + offset[1]);
+                }
+            }
+        }
+        sink = sink + sum;
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double queries = (double)rounds * width * height * 4 * QUERY_TYPES;
+
+    return queries / seconds;
+}
+
+// benchmark both lookups for a single map
+void benchMap(const std::string & label, const Map & map, int rounds) {
+    double oldQps = timeQueries(map, rounds, [&](int x, int y) {
+        int found = 0;
+        if(oldGetGridElement<Diamond>(map, x, y)) found++;
+        if(oldGetGridElement<Receptor>(map, x, y)) found++;
+        if(oldGetGridElement<Portal>(map, x, y)) found++;
+        if(oldGetGridElement<Boost>(map, x, y)) found++;
+        return found;
+    });
+
+    double taggedQps = timeQueries(map, rounds, [&](int x, int y) {
+        int found = 0;
+        if(map.getGridElement<Diamond>(x, y)) found++;
+        if(map.getGridElement<Receptor>(x, y)) found++;
+        if(map.getGridElement<Portal>(x, y)) found++;
+        if(map.getGridElement<Boost>(x, y)) found++;
+        return found;
+    });
+
+    printf("%-24s %4dx%-4d %7zu %14.1f %14.1f %8.2fx\n", label.c_str(),
+        map.getWidth(), map.getHeight(), map.getEntities().size(),
+        oldQps / 1e6, taggedQps / 1e6, taggedQps / oldQps);
+}
+
+// fill a map with randomly placed entities at the given density
+void makeSyntheticMap(Map & map, int width, int height, float density, unsigned int seed) {
+    map.initMap(width, height, 32, 32);
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> chance(0.f, 1.f);
+
+    for(int y = 0; y < height; y++) {
+        for(int x = 0; x < width; x++) {
+            map.setTileParity(x, y, chance(rng) < 0.5f ? PARITY_GRAY : PARITY_PURPLE);
+
+            if(chance(rng) >= density) continue;
+
+            std::shared_ptr<Entity> entity;
+            switch(rng() % 4) {
+                case 0:     entity = std::make_shared<Diamond>(x, y, PARITY_GRAY);
+                            break;
+                case 1:     entity = std::make_shared<Boost>(x, y, PARITY_GRAY, 1, DIR_UP);
+                            break;
+                case 2:     entity = std::make_shared<Portal>(x, y, PARITY_GRAY);
+                            break;
+                default:    entity = std::make_shared<Receptor>(x, y, PARITY_PURPLE, "diamond");
+                            break;
+            }
+
+            map.addEntity(entity);
+        }
+    }
+}
+
+int main(int argc, char * argv[]) {
+    std::string mapsDir = argc > 1 ? argv[1] : "res/maps";
+
+    const int SHIPPED_ROUNDS = 20000;
+    const int SYNTHETIC_ROUNDS = 20;
+
+    printf("%-24s %9s %7s %14s %14s %9s\n", "map", "size", "ents",
+        "dyncast Mq/s", "tagged Mq/s", "speedup");
+
+    // shipped maps
+    std::vector<std::string> mapPaths;
+    for(auto & entry: fs::directory_iterator(mapsDir)) {
+        if(entry.path().extension() == ".tmx") {
+            mapPaths.push_back(entry.path().string());
+        }
+    }
+    std::sort(mapPaths.begin(), mapPaths.end());
+
+    for(auto & mapPath: mapPaths) {
+        Level level(mapPath);
+        benchMap(fs::path(mapPath).filename().string(), level.getMap(), SHIPPED_ROUNDS);
+    }
+
+    // synthetic maps at increasing entity densities
+    for(float density: {0.05f, 0.15f, 0.5f}) {
+        Map map;
+        makeSyntheticMap(map, 256, 256, density, 1234);
+
+        std::string label = "synthetic " + std::to_string((int)(density * 100)) + "%";
+        benchMap(label, map, SYNTHETIC_ROUNDS);
+    }
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+// Benchmark for batched rendering
+//
+// Renders large synthetic maps (background tiles plus an entity on every few
+// tiles, some rotated) with SDL's software renderer, once drawing each sprite
+// with its own SDL_RenderCopyEx and once through SpriteBatch. Tiles are scaled
+// so each map covers the same target, so the fill cost stays the same and the
+// difference is the per draw call overhead. Reports the average frame time of
+// each in ms, and draw calls per frame.
+//
+// usage: renderbench [spritesheets directory]
+
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+
+#include "utils/renderstats.hpp"
+#include "utils/spritebatch.hpp"
+#include "utils/sprite.hpp"
+#include "utils/texture.hpp"
+
+const int TARGET_SIZE = 1024;
+const int SPRITE_SIZE = 32;
+
+// one entity every ENTITY_SPACING tiles
+const int ENTITY_SPACING = 4;
+
+struct SyntheticMap {
+    int tileSize;
+    std::vector<std::pair<std::shared_ptr<Sprite>, SDL_Rect>> tiles;
+    std::vector<std::pair<std::shared_ptr<Sprite>, SDL_Rect>> entities;
+    std::vector<double> angles;
+};
+
+// a size x size map of random tiles/entities from the given spritesheets
+SyntheticMap makeMap(int size, std::shared_ptr<Texture> tileSheet,
+    std::shared_ptr<Texture> entitySheet) {
+    std::mt19937 rng(size);
+    SyntheticMap map;
+    map.tileSize = TARGET_SIZE / size;
+
+    int tileColumns = tileSheet->getWidth() / SPRITE_SIZE;
+    int entityColumns = entitySheet->getWidth() / SPRITE_SIZE;
+
+    for(int i = 0; i < size * size; i++) {
+        SDL_Rect area = {(i % size) * map.tileSize, (i / size) * map.tileSize,
+            map.tileSize, map.tileSize};
+
+        // a tile of either parity
+        int tile = rng() % 2;
+        SDL_Rect clip = {(tile % tileColumns) * SPRITE_SIZE, (tile / tileColumns) * SPRITE_SIZE,
+            SPRITE_SIZE, SPRITE_SIZE};
+        map.tiles.emplace_back(std::make_shared<Sprite>(tileSheet, clip), area);
+
+        if(i % ENTITY_SPACING == 0) {
+            int entity = rng() % (entityColumns * 2);
+            clip = {(entity % entityColumns) * SPRITE_SIZE, (entity / entityColumns) * SPRITE_SIZE,
+                SPRITE_SIZE, SPRITE_SIZE};
+            map.entities.emplace_back(std::make_shared<Sprite>(entitySheet, clip), area);
+            map.angles.push_back((rng() % 4) * 90.0);
+        }
+    }
+
+    return map;
+}
+
+void renderMap(SDL_Renderer * renderer, const SyntheticMap & map) {
+    SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF);
+    SDL_RenderClear(renderer);
+
+    SpriteBatch::begin(renderer);
+
+    for(auto & tile: map.tiles) {
+        tile.first->render(renderer, tile.second);
+    }
+
+    for(unsigned int i = 0; i < map.entities.size(); i++) {
+        map.entities[i].first->render(renderer, map.entities[i].second, map.angles[i]);
+    }
+
+    SpriteBatch::end();
+
+    SDL_RenderPresent(renderer);
+    RenderStats::endFrame();
+}
+
+struct FrameTiming {
+    double ms;
+    int drawCalls;
+};
+
+FrameTiming timeFrames(SDL_Renderer * renderer, const SyntheticMap & map, bool batched,
+    int frames) {
+    SpriteBatch::setEnabled(batched);
+    renderMap(renderer, map);
+
+    auto start = std::chrono::steady_clock::now();
+    for(int frame = 0; frame < frames; frame++) {
+        renderMap(renderer, map);
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    return {std::chrono::duration<double>(end - start).count() * 1e3 / frames,
+        RenderStats::getDrawCalls()};
+}
+
+std::shared_ptr<Texture> loadSheet(const std::string & path, SDL_Renderer * renderer) {
+    auto sheet = std::make_shared<Texture>();
+    if(!sheet->loadSurface(path)) {
+        printf("Error loading %s, %s\n", path.c_str(), SDL_GetError());
+        return nullptr;
+    }
+
+    sheet->uploadSurface(renderer);
+    return sheet;
+}
+
+int main(int argc, char * argv[]) {
+    std::string sheetsDir = argc > 1 ? argv[1] : "res/spritesheets";
+
+    const int FRAMES = 20;
+    const int MAP_SIZES[] = {32, 64, 128, 256};
+
+    std::shared_ptr<SDL_Surface> target(SDL_CreateRGBSurfaceWithFormat(0, TARGET_SIZE,
+        TARGET_SIZE, 32, SDL_PIXELFORMAT_RGBA32), SDL_FreeSurface);
+    SDL_Renderer * renderer = target.get() ? SDL_CreateSoftwareRenderer(target.get()) : NULL;
+
+    if(renderer == NULL) {
+        printf("Error creating software renderer, %s\n", SDL_GetError());
+        return 1;
+    }
+
+    auto tileSheet = loadSheet(sheetsDir + "/levelSpritesheet.png", renderer);
+    auto entitySheet = loadSheet(sheetsDir + "/entitySpritesheet.png", renderer);
+    if(!tileSheet.get() || !entitySheet.get()) return 1;
+
+    printf("%-10s %9s %12s %8s %12s %8s %9s\n", "map", "sprites",
+        "copies ms", "calls", "batched ms", "calls", "speedup");
+
+    for(int size: MAP_SIZES) {
+        SyntheticMap map = makeMap(size, tileSheet, entitySheet);
+
+        FrameTiming copies = timeFrames(renderer, map, false, FRAMES);
+        FrameTiming batched = timeFrames(renderer, map, true, FRAMES);
+
+        printf("%4dx%-5d %9zu %12.2f %8d %12.2f %8d %8.1fx\n", size, size,
+            map.tiles.size() + map.entities.size(), copies.ms, copies.drawCalls,
+            batched.ms, batched.drawCalls, copies.ms / batched.ms);
+    }
+
+    SDL_DestroyRenderer(renderer);
+    return 0;
+}
@@ -0,0 +1,228 @@
+// Benchmark for the simulation, replaying solutions of every level
+//
+// For each map listed under "maps" in res_paths.json, replays a solution
+// through the headless simulation (Level::step) over and over for a while,
+// then reports the ticks (simulation inputs stepped) per second, heap
+// allocations per tick, how much the process' RSS grew while replaying and
+// the level's wall time (load, solve and replaying). Solutions come from the
+// level's recorded replay (see level/replay.hpp) when there's one in the
+// replays directory, otherwise from the solver. The results are written as
+// JSON as well, to compare between builds.
+//
+// usage: replaybench [-r replays directory] [-o results file] [-s seconds]
+//                    [res_paths.json]
+//        -r uses <replays directory>/<level ID>.rpl where there's one
+//           (default: the replays directory next to res_paths.json)
+//        -o writes the results to the given file (default: replaybench.json)
+//        -s replays each level for about the given seconds (default: 0.5)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#ifdef _WIN32
+#define PSAPI_VERSION 2
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#endif
+
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+
+#include "level/level.hpp"
+#include "level/replay.hpp"
+#include "solver/solver.hpp"
+#include "utils/allocstats.hpp"
+
+using json = nlohmann::json;
+namespace fs = std::filesystem;
+
+// current resident set size of the process, in KB
+long currentRSS() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return counters.WorkingSetSize / 1024;
+#elif defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if(task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info,
+        &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.resident_size / 1024;
+#else
+    // resident pages are the second field
+    long pages = 0, residentPages = 0;
+    FILE * statm = fopen("/proc/self/statm", "r");
+    if(!statm) return 0;
+
+    int read = fscanf(statm, "%ld %ld", &pages, &residentPages);
+    fclose(statm);
+
+    return read == 2 ? residentPages * (sysconf(_SC_PAGESIZE) / 1024) : 0;
+#endif
+}
+
+struct ReplayTiming {
+    long long iterations = 0;
+    long long ticks = 0;
+    double seconds = 0.0;
+    long long allocs = 0;
+    long rssGrowth = 0;
+};
+
+// replay the inputs from the level as loaded, until at least minSeconds pass
+ReplayTiming timeReplays(Level & level, const std::vector<uint8_t> & steps,
+    double minSeconds) {
+    ReplayTiming timing;
+
+    long long allocations = AllocStats::getAllocations();
+    long rss = currentRSS();
+    auto start = std::chrono::steady_clock::now();
+
+    do {
+        level.reset();
+        for(uint8_t input: steps) {
+            level.step((SimInput)input);
+        }
+
+        timing.iterations++;
+        timing.seconds = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+    } while(timing.seconds < minSeconds);
+
+    timing.allocs = AllocStats::getAllocations() - allocations;
+    timing.rssGrowth = currentRSS() - rss;
+    timing.ticks = timing.iterations * steps.size();
+
+    return timing;
+}
+
+int main(int argc, char * argv[]) {
+    std::string resPathsFile = "res/res_paths.json";
+    std::string replaysDir;
+    std::string resultsFile = "replaybench.json";
+    double minSeconds = 0.5;
+
+    for(int i = 1; i < argc; i++) {
+        if(std::strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            replaysDir = argv[++i];
+        } else if(std::strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            resultsFile = argv[++i];
+        } else if(std::strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            minSeconds = std::atof(argv[++i]);
+        } else {
+            resPathsFile = argv[i];
+        }
+    }
+
+    std::ifstream resPaths(resPathsFile);
+    json resJson = json::parse(resPaths, nullptr, false);
+
+    if(resJson.is_discarded() || !resJson.contains("maps")) {
+        printf("Error loading the maps listed in %s\n", resPathsFile.c_str());
+        return 1;
+    }
+
+    fs::path mapsDir = fs::path(resPathsFile).parent_path() / "maps";
+    if(replaysDir.empty()) {
+        replaysDir = (fs::path(resPathsFile).parent_path() / "replays").string();
+    }
+
+    int threads = std::max((int)std::thread::hardware_concurrency(), 1);
+
+    printf("%-10s %-8s %7s %10s %13s %12s %10s %10s\n", "level", "source",
+        "inputs", "ticks", "ticks/s", "allocs/tick", "RSS +KB", "wall ms");
+
+    json results;
+    results["levels"] = json::array();
+
+    int failed = 0;
+    auto benchStart = std::chrono::steady_clock::now();
+
+    for(auto & map: resJson["maps"].items()) {
+        std::string levelID = map.key();
+        std::string mapPath = (mapsDir / map.value().get<std::string>()).string();
+
+        auto levelStart = std::chrono::steady_clock::now();
+
+        // the recorded solution, or else the solver's
+        Replay replay;
+        std::string source = "replay";
+        std::string replayPath = replaysDir + "/" + levelID + ".rpl";
+
+        if(!fs::exists(replayPath) || !replay.load(replayPath)) {
+            Solver solver(mapPath);
+            SolverResult solution = solver.solve(threads);
+
+            if(!solution.solved) {
+                // without a recorded replay, there's nothing to replay
+                printf("%-10s %-8s\n", levelID.c_str(), "unsolved");
+                results["levels"].push_back({{"level", levelID}, {"source", "unsolved"}});
+                continue;
+            }
+
+            source = "solver";
+            replay = Replay(levelID);
+            for(SimInput input: solution.moves) {
+                replay.recordStep(input);
+            }
+        }
+
+        Level level(mapPath);
+        bool matches = source != "replay" || replay.verify(level);
+        if(!matches) failed++;
+
+        ReplayTiming timing = timeReplays(level, replay.getSteps(), minSeconds);
+
+        double wallMs = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - levelStart).count();
+        double ticksPerSecond = timing.ticks / timing.seconds;
+        double allocsPerTick = timing.ticks ? (double)timing.allocs / timing.ticks : 0.0;
+
+        printf("%-10s %-8s %7zu %10lld %13.0f %12.3f %10ld %10.1f%s\n", levelID.c_str(),
+            source.c_str(), replay.getSteps().size(), timing.ticks, ticksPerSecond,
+            allocsPerTick, timing.rssGrowth, wallMs, matches ? "" : "  (diverged)");
+        fflush(stdout);
+
+        results["levels"].push_back({
+            {"level", levelID},
+            {"source", source},
+            {"inputs", replay.getSteps().size()},
+            {"iterations", timing.iterations},
+            {"ticks", timing.ticks},
+            {"ticks_per_sec", ticksPerSecond},
+            {"allocs_per_tick", allocsPerTick},
+            {"rss_growth_kb", timing.rssGrowth},
+            {"wall_ms", wallMs},
+            {"matches", matches}
+        });
+    }
+
+    results["total_wall_ms"] = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - benchStart).count();
+
+    std::ofstream out(resultsFile);
+    out << results.dump(4) << "\n";
+
+    if(!out.good()) {
+        printf("Error writing results to %s\n", resultsFile.c_str());
+        return 1;
+    }
+
+    printf("results written to %s\n", resultsFile.c_str());
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,93 @@
+// Benchmark for level resets
+//
+// Compares the old reset (clearing the map and reloading it from its .tmx
+// file) against restoring the state captured when the level was loaded.
+// Resets are timed after a few random moves, so there's state to restore.
+// Reports the average latency of each in us, and heap allocations per reset.
+//
+// usage: resetbench [maps directory]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "level/level.hpp"
+#include "utils/allocstats.hpp"
+
+namespace fs = std::filesystem;
+
+const SimInput MOVES[4] = {INPUT_UP, INPUT_DOWN, INPUT_LEFT, INPUT_RIGHT};
+
+struct ResetTiming {
+    double us;
+    double allocs;
+};
+
+// average the latency/allocations of reset over rounds resets, playing a
+// few random moves before each (untimed)
+template <class F>
+ResetTiming timeResets(Level & level, int rounds, F reset) {
+    std::mt19937 rng(1234);
+    double seconds = 0.0;
+    long long allocs = 0;
+
+    for(int round = 0; round < rounds; round++) {
+        for(int i = 0; i < 8; i++) level.step(MOVES[rng() % 4]);
+
+        long long allocsBefore = AllocStats::getAllocations();
+        auto start = std::chrono::steady_clock::now();
+        reset();
+        auto end = std::chrono::steady_clock::now();
+
+        seconds += std::chrono::duration<double>(end - start).count();
+        allocs += AllocStats::getAllocations() - allocsBefore;
+    }
+
+    return {seconds * 1e6 / rounds, (double)allocs / rounds};
+}
+
+int main(int argc, char * argv[]) {
+    std::string mapsDir = argc > 1 ? argv[1] : "res/maps";
+
+    const int RELOAD_ROUNDS = 200;
+    const int RESTORE_ROUNDS = 20000;
+
+    printf("%-24s %7s %12s %12s %12s %12s %9s\n", "map", "ents",
+        "reload us", "allocs", "restore us", "allocs", "speedup");
+
+    std::vector<std::string> mapPaths;
+    for(auto & entry: fs::directory_iterator(mapsDir)) {
+        if(entry.path().extension() == ".tmx") {
+            mapPaths.push_back(entry.path().string());
+        }
+    }
+    std::sort(mapPaths.begin(), mapPaths.end());
+
+    for(auto & mapPath: mapPaths) {
+        Level level(mapPath);
+
+        // the old reset: clear the map and reload it from the file
+        Map reloaded;
+        ResetTiming reload = timeResets(level, RELOAD_ROUNDS, [&]() {
+            reloaded.clear();
+            reloaded.loadMap(mapPath, &level);
+        });
+        level.reset();
+
+        ResetTiming restore = timeResets(level, RESTORE_ROUNDS, [&]() {
+            level.reset();
+        });
+
+        printf("%-24s %7zu %12.2f %12.1f %12.2f %12.1f %8.1fx\n",
+            fs::path(mapPath).filename().string().c_str(),
+            level.getMap().getEntities().size(), reload.us, reload.allocs,
+            restore.us, restore.allocs, reload.us / restore.us);
+    }
+
+    return 0;
+}
@@ -8,20 +8,14 @@
 
 class Diamond : public Movable {
     private:
-        static const int DIAMOND_VELOCITY = 3;
-
-        enum DiamondAnimation{ DIAMOND_MERGE };
+        bool checkInteractions(Level * level) override;
 
     public:
         const static std::string DIAMOND_SHAPE;
 
-        Diamond(int screenX, int screenY, int gridX, int gridY, int parity,
-            std::shared_ptr<Sprite> entitySprite,
-            const std::unordered_map<int, std::shared_ptr<Animation>> & entityAnimations);
+        Diamond(int gridX, int gridY, int parity);
 
-        void handleEvents(const Uint8 * keyStates, Level * level) override;
-        void update(Level * level, float delta) override;
-        void render(SDL_Renderer* renderer) const override;
+        static bool isKind(EntityKind kind) { return kind == ENTITY_DIAMOND; }
 };
 
-#endif // DIAMOND_HPP
\ No newline at end of file
+#endif // DIAMOND_HPP
@@ -1,20 +1,16 @@
 // Abstract base class for entities (not using ECS for this proj's simplicity)
+// Entities only hold simulation state; see view/entityview.hpp for rendering
 
 #ifndef ENTITY_HPP
 #define ENTITY_HPP
 
-#include <SDL.h>
-
-#include <string>
 #include <memory>
 #include <utility>
-#include <unordered_map>
-
-#include "utils/sprite.hpp"
-#include "utils/animator.hpp"
+#include <vector>
 
 class Level;
 class Map;
+class Entity;
 
 enum Direction {
     DIR_NONE,
@@ -30,6 +26,29 @@ enum Parity {
     PARITY_PURPLE   // 2 ~ purple
 };
 
+// concrete type of an entity, stored alongside it in the grid for typed lookups
+enum EntityKind {
+    ENTITY_NONE,
+    ENTITY_PLAYER,
+    ENTITY_DIAMOND,
+    ENTITY_BOOST,
+    ENTITY_RECEPTOR,
+    ENTITY_PORTAL
+};
+
+// mutable state of an entity, stored for undo
+struct EntityState {
+    int gridX, gridY;
+    bool vanished;
+
+    // if the entity occupies its cell in the grid
+    bool inGrid;
+
+    // entity ID of an entity specific link (eg the player's last portal), -1
+    // if none. Stored by ID so the state applies to any copy of the map
+    int link;
+};
+
 class Entity {
     protected:
         // x,y location in the grid
@@ -38,64 +57,45 @@ class Entity {
         // parity of the entity
         Parity parity;
 
-        // Texture for the entity
-        std::shared_ptr<Sprite> entitySprite;
-
-        // render area on the screen
-        SDL_Rect renderArea;
-
-        // rotation angle
-        double angle = 0.0;
-
-        // animator for this entity
-        Animator entityAnimator;
+        // concrete type of the entity
+        EntityKind kind;
 
-        // hold all animations to be used by this entity, key = enum ID val.
-        const std::unordered_map<int, std::shared_ptr<Animation>> & entityAnimations;
+        // index of the entity in its map
+        int entityID = -1;
 
-        // if entity is removed from the grid
+        // if entity is removed from play (consumed, merged, etc.)
         bool vanished = false;
 
     public:
-        // for grid-based entities
-        Entity(int screenX, int screenY, int gridX, int gridY, int parity, 
-            std::shared_ptr<Sprite> entitySprite,
-            const std::unordered_map<int, std::shared_ptr<Animation>> & entityAnimations);
+        Entity(int gridX, int gridY, int parity, EntityKind kind);
+        virtual ~Entity() {}
 
-        // for non grid-based entities (eg tiles)
-        Entity(int screenX, int screenY, int parity, 
-            std::shared_ptr<Sprite> entitySprite,
-            const std::unordered_map<int, std::shared_ptr<Animation>> & entityAnimations);
-
-        virtual void handleEvents(const Uint8 * keyStates, Level * level) = 0;
-        virtual void update(Level * level, float delta);
-        virtual void render(SDL_Renderer * renderer) const;
+        // if an entity of the given kind is an instance of this class
+        static bool isKind(EntityKind kind) { return kind != ENTITY_NONE; }
 
         static bool checkCollision(Level * level, int destGridX, int destGridY);
 
-        void stopAnimator();
+        // store/restore the entity's mutable state
+        virtual void saveState(EntityState & state) const;
+        // (links are looked up in the map's entities, by ID)
+        virtual void loadState(const EntityState & state,
+            const std::vector<std::shared_ptr<Entity>> & entities);
 
-        void setScreenX(int x);
-        void setScreenY(int y);
         void setGridX(int x);
         void setGridY(int y);
+        void setEntityID(int id);
 
-        void activateAnimation(int animationID, bool reverse = false);
-
-        int getScreenX() const;
-        int getScreenY() const;
-        int getWidth() const;
-        int getHeight() const;
         int getGridX() const;
         int getGridY() const;
+        int getEntityID() const;
 
         Parity getParity() const;
+        EntityKind getKind() const;
+
+        std::pair<int, int> getCoords(Direction direction) const;
 
-        std::pair<int, int> getCoords(Direction direction);
-        
         void setVanished(bool vanished);
         bool isVanished() const;
-        bool isAnimating() const;
 };
 
-#endif // ENTITY_HPP
\ No newline at end of file
+#endif // ENTITY_HPP
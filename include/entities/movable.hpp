@@ -3,103 +3,62 @@
 #ifndef MOVABLE_HPP
 #define MOVABLE_HPP
 
-#include <stack>
+#include <string>
+#include <memory>
 
 #include "entities/entity.hpp"
 #include "entities/boost.hpp"
 #include "entities/receptor.hpp"
 #include "level/level.hpp"
-#include "level/tile.hpp"
 
 class Movable : public Entity {
     public:
-        Movable(int screenX, int screenY, int gridX, int gridY, int velocity,
-            int parity, std::shared_ptr<Sprite> entitySprite, 
-            std::string movableShape,
-            const std::unordered_map<int, std::shared_ptr<Animation>> & entityAnimations);
+        Movable(int gridX, int gridY, int parity, EntityKind kind, std::string movableShape);
 
-        virtual void update(Level * level, float delta) override;
-        void render(SDL_Renderer* renderer) const override;  
-
-        static std::pair<int,int> lerp(int startX, int startY, int endX,
-            int endY, float t);
+        static bool isKind(EntityKind kind) {
+            return kind == ENTITY_PLAYER || kind == ENTITY_DIAMOND;
+        }
 
-        Direction currCheckDir() const;
+        // resolve a full move (including boosts) in the specified direction,
+        // returns true if the entity changed position
+        virtual bool move(Level * level, Direction direction);
 
         template <class T>
-        std::shared_ptr<T> getEntity(Level * level, Direction direction) {
+        T * getEntity(Level * level, Direction direction) {
             std::pair<int, int> coords = getCoords(direction);
             return level->getGridElement<T>(coords.first, coords.second);
         }
 
-        void setMoveDir(Direction direction);
-        float getMoveProg() const;
+        // if merged/merging with a receptor
         bool isMerging() const;
-        bool isMoving() const;
-
-        // enum of actions to store play history for undo functionality
-        enum MovableAction {
-            MOVE_LEFT, MOVE_RIGHT, MOVE_UP, MOVE_DOWN,
-            BOOST_LEFT, BOOST_RIGHT, BOOST_UP, BOOST_DOWN, BOOST_NONE, // dummy boost-inplace
-            MERGE,
-            // (player exclusive actions)
-            PUSH, TELEPORT
-        };
-
-        virtual void undoAction(Level * level);
 
     protected:
-        // Movement progress + tracking
-        float moveProg = 0.f;
-        const float MOVEMENT_BUFFER = 0.85f;
-
-        int startX, startY, endX, endY;   // Start and end positions for movement
-
-        Direction moveDir = DIR_NONE;     // direction of entity's move
-        Direction bufferedDir = DIR_NONE; // direction of entity's buffered move
-
-        int velocity;                     // Pixels moved per sec.
+        Direction moveDir = DIR_NONE;     // direction of entity's current step
 
         // for tracking boost status of movable entities
         int boostPower = 0;
 
-        // stack of actions
-        std::stack<MovableAction> actionHistory;
+        // if the last step was succesful
+        bool moving = false;
 
-        // for storing boosters upon activation
-        std::stack<std::shared_ptr<Boost>> boosters;
+        // the receptor merged with during the current move
+        Receptor * mReceptor = nullptr;
 
-        // the receptor to merge with
-        std::shared_ptr<Receptor> mReceptor;
+        std::string movableShape;
 
-        // the last portal the entity used
-        std::shared_ptr<Portal> lastPortal;
-        
-        // if merging with a receptor/moving
-        bool merging = false;
-        bool moving = false;
+        // take a single step in moveDir, returns true if onto a boost
+        bool step(Level * level);
 
-        std::string movableShape;
-        
-        inline const static std::string MERGE_SOUND_ID = "merge";
+        // entity specific interactions before each step, return false to
+        // cancel the step
+        virtual bool checkInteractions(Level * level);
 
         // initialize movement from a direction
         void initMovement(Direction direction, Level * level);
-        void initMovement(int xPosChange, int yPosChange, int xGridChange, 
-            int yGridChange, Direction direction, Level * level);
-        
-        // update the entity's position
-        void move(Level * level, float delta);
 
         // check for a boost entity
         bool checkBoost(Level * level, Direction direction);
         void checkReceptor(Level * level);
-
-        void addMoveToHistory(Direction direction);
-
-        void undoMovement(Direction direction, Level * level);
-        void undoBoost(Direction direction, Level * level, MovableAction lastAction);
-        void undoMerge(Level * level);
 };
 
-#endif // MOVABLE_HPP
\ No newline at end of file
+#endif // MOVABLE_HPP
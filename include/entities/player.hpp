@@ -4,7 +4,6 @@
 #define PLAYER_HPP
 
 #include <utility>
-#include <SDL.h>
 
 #include "entities/movable.hpp"
 
@@ -12,54 +11,34 @@ class Portal;
 
 class Player : public Movable {
     private:
-        static const int PLAYER_VELOCITY = 6;
-
-        // track when a player is undoing a buffer/set to BUFFER_CAP each time
-        static const int UNDO_BUFFER_CAP = 10;
-        int undoBuffer = 0;
-
-        int movesUndone = 0;
+        // the last portal the player used (owned by the map)
+        Portal * lastPortal = nullptr;
 
         bool teleporting = false;
-        bool stuck = false;
-
-        // maintain stack of pointers to objects pushed by player for undo purposes
-        std::stack<std::shared_ptr<Movable>> pushedObjects;
 
         inline const static std::string PLAYER_SHAPE = "player";
-        inline const static std::string BONK_SOUND_ID = "bonk";
-        
-        // check if player has input movement
-        void checkMovement(const Uint8 * keyStates, Level * level);
+
+        bool checkInteractions(Level * level) override;
 
         // try to push a diamond
-        void pushDiamond(Level * level);
+        bool pushDiamond(Level * level);
 
         // check for portal
         void checkPortal(Level * level);
 
-        void undoAction(Level * level) override;
     public:
-        enum PlayerAnimation {PLAYER_MERGE, PLAYER_MOVEFAIL_UP, PLAYER_MOVEFAIL_DOWN,
-            PLAYER_MOVEFAIL_LEFT, PLAYER_MOVEFAIL_RIGHT, PLAYER_TELEPORT};
-
-        Player(int screenX, int screenY, int gridX, int gridY, int parity,
-            std::shared_ptr<Sprite> entitySprite,
-            const std::unordered_map<int, std::shared_ptr<Animation>> & entityAnimations);
-
-        // game loop stuff
-        void handleEvents(const Uint8 * keyStates, Level * level) override;
-        void update(Level * level, float delta) override;
-        void render(SDL_Renderer* renderer) const override;
+        Player(int gridX, int gridY, int parity);
 
-        bool isTeleporting() const;
-        void setTeleporting(bool teleporting);
+        static bool isKind(EntityKind kind) { return kind == ENTITY_PLAYER; }
 
-        int getMovesUndone() const;
+        bool move(Level * level, Direction direction) override;
 
-        void pushAction(MovableAction action);
+        void saveState(EntityState & state) const override;
+        void loadState(const EntityState & state,
+            const std::vector<std::shared_ptr<Entity>> & entities) override;
 
-        void setLastPortal(std::shared_ptr<Portal> lastPortal);
+        void setLastPortal(Portal * lastPortal);
+        Portal * getLastPortal() const;
 };
 
-#endif // PLAYER_HPP
\ No newline at end of file
+#endif // PLAYER_HPP
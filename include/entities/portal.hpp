@@ -9,48 +9,22 @@ class Player;
 
 class Portal : public Entity {
     private:
-        bool activated = false;
-        bool removed = false;
-
-        enum PortalAnimation {PORTAL_MERGE};
-
-        // the corresponding portal
-        std::shared_ptr<Portal> otherPortal;
-
-        // the player being teleported by this portal
-        std::shared_ptr<Player> player;
-
-        inline const static std::string TELEPORT_SOUND_ID = "teleport";
-
-        void resetPortalStatus(Level * level);
+        // the corresponding portal (owned by the map)
+        Portal * otherPortal = nullptr;
 
     public:
-        Portal(int screenX, int screenY, int gridX, int gridY, int parity,
-            std::shared_ptr<Sprite> entitySprite,
-            const std::unordered_map<int, std::shared_ptr<Animation>> & entityAnimations);
+        Portal(int gridX, int gridY, int parity);
 
-        void handleEvents(const Uint8 * keyStates, Level * level) override;
-        void update(Level * level, float delta) override;
-        void render(SDL_Renderer* renderer) const override;
+        static bool isKind(EntityKind kind) { return kind == ENTITY_PORTAL; }
 
-        // check if surrounded by purple tiles -> merge animation
+        // check if surrounded by purple tiles -> vanish
         void checkSurrounded(Level * level);
 
-        // teleport the player
-        void teleportPlayer(Level * level, bool undo = false);
-
-        // temporarily lift portals from grid
-        void removePortals(Level * level);
-
-        void setPlayer(std::shared_ptr<Player> player);
-        void setOtherPortal(std::shared_ptr<Portal> otherPortal);
-
-        std::shared_ptr<Player> getPlayer() const;
+        // teleport the player to the other portal
+        void teleportPlayer(Level * level, Player * player);
 
-        void setRemoved(bool removed);
-        bool isRemoved() const;
-        void setActivated(bool activated);
-        bool isActivated() const;
+        void setOtherPortal(Portal * otherPortal);
+        Portal * getOtherPortal() const;
 };
 
-#endif // PORTAL_HPP
\ No newline at end of file
+#endif // PORTAL_HPP
@@ -3,28 +3,24 @@
 #ifndef RECEPTOR_HPP
 #define RECEPTOR_HPP
 
+#include <string>
+
 #include "entities/entity.hpp"
 
 class Receptor : public Entity {
     private:
-        // track if receptor is completed
-        bool completed = false;
-
         std::string shape;
 
     public:
-        Receptor(int screenX, int screenY, int gridX, int gridY, int parity,
-            std::shared_ptr<Sprite> entitySprite, std::string shape,
-            const std::unordered_map<int, std::shared_ptr<Animation>> & entityAnimations);
+        Receptor(int gridX, int gridY, int parity, std::string shape);
 
-        void handleEvents(const Uint8 * keyStates, Level * level) override;
-        void update(Level * level, float delta) override;
-        void render(SDL_Renderer* renderer) const override;
+        static bool isKind(EntityKind kind) { return kind == ENTITY_RECEPTOR; }
 
+        // receptors are completed (vanish) once merged with
         void setCompleted(bool completed);
         bool isCompleted() const;
 
-        std::string getShape() const;
+        const std::string & getShape() const;
 };
 
-#endif // RECEPTOR_HPP
\ No newline at end of file
+#endif // RECEPTOR_HPP
@@ -8,6 +8,7 @@
 
 #include <SDL.h>
 
+#include "utils/resids.hpp"
 #include "utils/texture.hpp"
 
 enum GameStateID {
@@ -26,8 +27,8 @@ class GameState {
         int gameStateID;
         SDL_Event e;
 
-        inline const static std::string ACTIVATE_SOUND_ID = "menuActivate";
-        inline const static std::string SWITCH_SOUND_ID = "menuSwitch";
+        inline const static ResId ACTIVATE_SOUND_ID = RES_MENU_ACTIVATE;
+        inline const static ResId SWITCH_SOUND_ID = RES_MENU_SWITCH;
 
     public:
         GameState(int stateID) : gameStateID(stateID) {};
@@ -47,7 +48,11 @@ class GameState {
         /// Render function for the game state
         virtual void render(SDL_Renderer * renderer) const = 0;
 
-        void fade(SDL_Renderer * renderer, MemSwap * game, bool in) const;
+        // if nothing on screen changes until there's input (so frames can be
+        // skipped), states with animations that always play are never idle
+        virtual bool isIdle() const {
+            return false;
+        }
 
         int getGameStateID() {
             return gameStateID;
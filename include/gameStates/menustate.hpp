@@ -79,18 +79,18 @@ class MenuState : public GameState {
 
         // ID's for gui resources
         
-        inline const static std::string FONT_ID = "mainFont";
-        inline const static std::string BG_ID = "play_menu_bg";
-        inline const static std::string MENU_BUTTON_ID = "menu_menu_btn";
-        inline const static std::string LVL_BUTTON_ID = "menu_lvl_btn";
-        inline const static std::string LVL_LOCKED_ID = "menu_lvl_locked";
-        inline const static std::string BACK_BUTTON_ID = "menu_back_btn";
-        inline const static std::string MENU_LABEL_LONG_ID = "menu_label_long";
-        inline const static std::string MENU_LABEL_SHORT_ID = "menu_label_short";
-        inline const static std::string MENU_TEXT_BOARD_ID = "menu_text_board";
-        inline const static std::string MENU_HTP_BOARD_ID = "menu_htp_board";
+        inline const static ResId FONT_ID = RES_MAIN_FONT;
+        inline const static ResId BG_ID = RES_PLAY_MENU_BG;
+        inline const static ResId MENU_BUTTON_ID = RES_MENU_MENU_BTN;
+        inline const static ResId LVL_BUTTON_ID = RES_MENU_LVL_BTN;
+        inline const static ResId LVL_LOCKED_ID = RES_MENU_LVL_LOCKED;
+        inline const static ResId BACK_BUTTON_ID = RES_MENU_BACK_BTN;
+        inline const static ResId MENU_LABEL_LONG_ID = RES_MENU_LABEL_LONG;
+        inline const static ResId MENU_LABEL_SHORT_ID = RES_MENU_LABEL_SHORT;
+        inline const static ResId MENU_TEXT_BOARD_ID = RES_MENU_TEXT_BOARD;
+        inline const static ResId MENU_HTP_BOARD_ID = RES_MENU_HTP_BOARD;
         
-        inline const static std::string MENU_MUSIC_ID = "menuMusic";
+        inline const static ResId MENU_MUSIC_ID = RES_MENU_MUSIC;
 
         // titles/labels for menu screens
         inline const static std::string LVL_SELECT_TITLE = "Level Select";
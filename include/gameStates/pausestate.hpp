@@ -33,9 +33,9 @@ class PauseState : public GameState {
         // Texture to show in the background
         std::shared_ptr<Texture> bgTexture;
 
-        const std::string BG_ID = "pause_bg";
-        const std::string BUTTON_ID = "menu_menu_btn";
-        const std::string FONT_ID = "mainFont";
+        const ResId BG_ID = RES_PAUSE_BG;
+        const ResId BUTTON_ID = RES_MENU_MENU_BTN;
+        const ResId FONT_ID = RES_MAIN_FONT;
 
         // Button labels
         const std::vector<std::string> BUTTON_LABELS = {"Resume",
@@ -8,6 +8,11 @@
 
 #include "gameStates/gamestate.hpp"
 #include "level/level.hpp"
+#include "level/levelloader.hpp"
+#include "level/replay.hpp"
+#include "solver/hintengine.hpp"
+#include "view/levelview.hpp"
+#include "utils/bitmapfont.hpp"
 #include "utils/music.hpp"
 
 #include "gui/label.hpp"
@@ -17,6 +22,10 @@
 class PlayState : public GameState {
     private:
         Level level;
+        LevelView levelView;
+
+        // loads the next level while the postgame board is up
+        LevelLoader levelLoader;
 
         // for post-level completion menu (popup window)
         Label postGameBoard;
@@ -28,14 +37,14 @@ class PlayState : public GameState {
             "Next Level", "Main Menu", "Level Select"
         };
 
-        inline const static std::string FONT_ID = "mainFont";
-        inline const static std::string BUTTON_ID = "menu_menu_btn";
-        inline const static std::string POSTGAME_BOARD_ID = "play_postgame_board";
+        inline const static ResId FONT_ID = RES_MAIN_FONT;
+        inline const static ResId BUTTON_ID = RES_MENU_MENU_BTN;
+        inline const static ResId POSTGAME_BOARD_ID = RES_PLAY_POSTGAME_BOARD;
 
         inline const static std::string POSTGAME_TEXT = "Level Complete!";
 
-        inline const static std::string COMPLETE_SOUND_ID = "complete";
-        inline const static std::string PLAY_MUSIC_ID = "playMusic";
+        inline const static ResId COMPLETE_SOUND_ID = RES_COMPLETE;
+        inline const static ResId PLAY_MUSIC_ID = RES_PLAY_MUSIC;
 
         // enum for postgame menu buttons
         enum PGButton {
@@ -54,10 +63,69 @@ class PlayState : public GameState {
         // after a level is completed
         bool levelComplete = false;
 
+        // background solver for hints ('h'), the state a hint was asked for
+        // and the last hint found
+        HintEngine hintEngine;
+        uint64_t hintHash = 0;
+        bool hintPending = false;
+        bool hintKeyHeld = false;
+
+        bool showingHint = false;
+        Hint currHint;
+
+        // ms the last hint search took (-1 before any, see PerfOverlay)
+        double hintLatency = -1.0;
+
+        std::shared_ptr<BitmapFont> hintFont;
+        SDL_Color hintColor;
+        inline const static int HINT_TEXT_PAD = 8;
+        inline const static int HINT_TEXT_MAX = 64;
+
+        // the hint's text, laid out when it's found (not every frame)
+        std::vector<Glyph> hintGlyphs;
+
+        inline const static std::string NO_HINT_TEXT = "No hint found";
+        inline const static std::string UNSOLVABLE_TEXT = "No solution, undo or reset";
+        inline const static std::string CAPPED_TEXT = "Search too large, no hint";
+
         std::shared_ptr<Music> playMusic;
 
+        // recording of the current level (if recording replays, see MemSwap)
+        std::string recordDir;
+        Replay recorded;
+        bool recording = false;
+
+        // replay whose keys are fed in place of the keyboard, and the inputs
+        // stepped while playing it back (to compare against the recorded ones)
+        std::shared_ptr<Replay> playback;
+        Replay playedBack;
+
+        // keyboard state each tick reads: the played back keys, or the keys
+        // held plus any pressed since the last tick (so a tap released
+        // between ticks isn't missed)
+        Uint8 tickKeyStates[SDL_NUM_SCANCODES] = {};
+        uint8_t pressedKeys = 0;
+
+        // scancodes of the keys recorded, in ReplayKey flag order
+        inline const static int REPLAY_SCANCODES[] = {
+            SDL_SCANCODE_W, SDL_SCANCODE_S, SDL_SCANCODE_A, SDL_SCANCODE_D,
+            SDL_SCANCODE_U, SDL_SCANCODE_R, SDL_SCANCODE_ESCAPE, SDL_SCANCODE_H
+        };
+
+        uint8_t toReplayKeys(const Uint8 * keyStates) const;
+        const Uint8 * toKeyStates(uint8_t keys);
+
+        // start recording/playing back the level just loaded, and save the
+        // recording/check the playback once done
+        void startReplay(MemSwap * game);
+        void finishPlayback(MemSwap * game);
+
         void handlePGActivation(MemSwap * game);
 
+        void requestHint(MemSwap * game);
+        void layoutHintText();
+        void clearHint();
+
     public:
         PlayState(MemSwap * game);
 
@@ -66,14 +134,29 @@ class PlayState : public GameState {
 
         // helper function to load levels
         void loadLevel(MemSwap * game, bool enteringState = false);
+        void swapInLevel(MemSwap * game);
 
         void updateStats(MemSwap * game);
 
+        // save the recording of the current level (if recording)
+        void finishRecording();
+
         void handleEvents(MemSwap * game, const SDL_Event & e) override;
+
+        // note a key pressed between ticks (from the polled events)
+        void keyPressed(const SDL_Event & e);
+
         void update(MemSwap * game, float delta) override;
         void render(SDL_Renderer * renderer) const override;
 
+        bool isIdle() const override;
+
         bool levelIsComplete() const;
+
+        // entities in the level that haven't vanished
+        int getEntityCount() const;
+
+        double getHintLatency() const;
 };
 
 #endif // PLAYSTATE_HPP
\ No newline at end of file
@@ -32,9 +32,9 @@ class SplashState : public GameState {
         // font for splash text rendering
         std::shared_ptr<BitmapFont> splashFont; 
     
-        const std::string BG_ID = "splash_bg";
-        const std::string LOAD_ANIM_ID = "loading";
-        const std::string FONT_ID = "mainFont";
+        const ResId BG_ID = RES_SPLASH_BG;
+        const ResId LOAD_ANIM_ID = RES_LOADING;
+        const ResId FONT_ID = RES_MAIN_FONT;
         const std::string ADV_TEXT = "Press Enter to Start...";
         const std::string LOADING_TEXT = "Loading...";
 
@@ -44,6 +44,14 @@ class SplashState : public GameState {
         int loadX, loadY;
 
         bool loadingRes = true;     // if we're loading resources
+
+        // loading progress bar (below the loading animation)
+        float loadProgress = 0.f;
+        int progressX = 0, progressY = 0;
+        SDL_Color progressColor;
+        const int PROGRESS_WIDTH = 96;
+        const int PROGRESS_HEIGHT = 4;
+        const int PROGRESS_PAD = 8;
         bool advance = false;       // if the user wants to advance
 
         // typed/flashing advance message
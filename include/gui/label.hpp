@@ -3,6 +3,8 @@
 #ifndef LABEL_HPP
 #define LABEL_HPP
 
+#include <vector>
+
 #include "utils/texture.hpp"
 #include "utils/bitmapfont.hpp"
 
@@ -29,7 +31,7 @@ class Label {
         void render(SDL_Renderer * renderer) const;
 
         void setText(std::string text);
-        std::string getText() const;
+        const std::string & getText() const;
         int getScreenX() const;
         int getScreenY() const;
         int getWidth() const;
@@ -62,10 +64,14 @@ class Label {
 
         bool hasText;
 
+        // the text, laid out when it's set (rather than on every render)
+        std::vector<Glyph> textGlyphs;
+
         bool hasGraphic = false;
 
         int initTextX() const;
         int initTextY() const;
+        void layoutText();
 };
 
 #endif //LABEL_HPP
\ No newline at end of file
@@ -0,0 +1,65 @@
+// Performance overlay gui element
+
+#ifndef PERFOVERLAY_HPP
+#define PERFOVERLAY_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <SDL.h>
+
+#include "utils/bitmapfont.hpp"
+#include "utils/framehistogram.hpp"
+
+// Shows the frame rate, frame time percentiles (since shown), draw calls and
+// texture switches of the last frame, live entities, allocations made in
+// the last frame and the last hint's latency. So it doesn't perturb what it measures, its text is only
+// laid out (to cached glyphs, see BitmapFont::layoutText) every REFRESH_MS,
+// without allocating, and its own draws aren't counted (see MemSwap::render).
+class PerfOverlay {
+    private:
+        bool shown = false;
+        bool everShown = false;
+
+        // frame times for the session (saved on exit), and since shown
+        FrameHistogram sessionHistogram;
+        FrameHistogram shownHistogram;
+
+        long long lastAllocations = 0;
+        long long frameAllocations = 0;
+
+        // frames rendered since the last refresh
+        int renderedFrames = 0;
+        Uint32 lastRefresh = 0;
+
+        std::shared_ptr<BitmapFont> font;
+        std::vector<Glyph> glyphs;
+        SDL_Rect backing = {0, 0, 0, 0};
+
+        inline const static Uint32 REFRESH_MS = 500;
+        const static int MAX_GLYPHS = 256;
+        const static int PAD = 8;
+
+    public:
+        PerfOverlay();
+
+        // count a frame presented, given the time since the last one was and
+        // the allocations made so far
+        void recordFrame(float frameMs, long long allocations);
+
+        // refresh the text (every REFRESH_MS) with the last frame's counts,
+        // and how long the last hint took (if < 0, there's been none)
+        void update(std::shared_ptr<BitmapFont> font, int screenWidth, int drawCalls,
+            int textureSwitches, int entities, double hintMs);
+
+        void render(SDL_Renderer * renderer) const;
+
+        void toggle();
+        bool isShown() const;
+
+        // save the session's frame times, if the overlay was used
+        void saveHistogram(const std::string & path) const;
+};
+
+#endif // PERFOVERLAY_HPP
@@ -3,29 +3,34 @@
 #ifndef LEVEL_HPP
 #define LEVEL_HPP
 
-#include <SDL.h>
 #include <tmxlite/Map.hpp>
 
 #include <string>
+#include <vector>
 
 #include "level/map.hpp"
+#include "level/simevent.hpp"
+#include "level/undolog.hpp"
 
-class MemSwap;
-class Texture;
 class Player;
+class Portal;
+class Replay;
 
+// Headless simulation of a single level. Advanced one input at a time with
+// step(), reporting what happened as a list of events (see view/levelview.hpp)
 class Level {
     private:
         // Width/height in tiles
-        int gridWidth, gridHeight;
+        int gridWidth = 0, gridHeight = 0;
 
         // Width/height in pixels
-        int pixelWidth, pixelHeight;
+        int pixelWidth = 0, pixelHeight = 0;
 
         // how many tiles have been flipped in this map
         int tilesFlipped = 0;
 
-        MemSwap * mGame;
+        // how many times the player has undone a move
+        int movesUndone = 0;
 
         // The map representation of the background
         Map map;
@@ -38,27 +43,81 @@ class Level {
 
         std::string mapPath;
 
+        // changes made by each move, for undo
+        UndoLog undoLog;
+
+        // state of the level as loaded, restored on reset
+        MapState initialState;
+
+        // the current state, while confirming an undo collapse
+        MapState collapseState;
+
+        // events produced by the last step (reserved up front, so stepping
+        // doesn't allocate)
+        std::vector<SimEvent> events;
+        inline const static int EVENTS_RESERVED = 256;
+
+        // replay the inputs stepped are recorded to (null if not recording)
+        Replay * recorder = nullptr;
+
+        static Direction inputDirection(SimInput input);
+
+        // reverse a logged change
+        void revert(const UndoRecord & record);
+
+        // drop the moves since the current state was last moved from
+        void collapseUndo();
+
+        // Zobrist hash of the entity state the map doesn't track: which
+        // entities have vanished and the player's last portal
+        uint64_t entityHash = 0;
+
+        // flag keys (see zobrist.hpp) of the player's last portal/vanished
+        // entities, by entity ID
+        inline const static int LINK_FLAG = Map::PORTALS_REMOVED_FLAG + 1;
+        inline const static int VANISHED_FLAG = LINK_FLAG + (1 << 16);
+
+        static uint64_t linkKey(const Entity * portal);
+        static uint64_t vanishedKey(const Entity * entity);
+        void rehashEntities();
+
     public:
         Level();
-        Level(std::string tiledMapPath, SDL_Renderer * renderer, MemSwap * game);
+        Level(std::string tiledMapPath);
+
+        // advance the simulation by one input, returns true if the state changed
+        bool step(SimInput input);
+
+        // undo the last move
+        bool undo();
+
+        // level reset (restores the state as loaded, without reloading the map)
+        void reset();
+
+        // record each input stepped to the given replay (null to stop)
+        void setRecorder(Replay * recorder);
 
-        // game loop
-        void handleEvents(const Uint8 * keyStates);
-        void update(float delta);
-        void render(SDL_Renderer * renderer) const;
+        // store/restore the full simulation state (eg. for solvers), restoring
+        // clears the undo history
+        void saveState(MapState & state) const;
+        void loadState(const MapState & state);
 
         // grid initialization
         void updateSize(const tmx::Map & map, int tileWidth, int tileHeight);
+        void updateSize(int gridWidth, int gridHeight, int tileWidth, int tileHeight);
 
-        void flipMapTiles(int movedFromX, int movedFromY, int entityParity, bool undo = false);
+        // changes to the level state, logged for undo
+        void flipMapTiles(int movedFromX, int movedFromY, int entityParity);
         void removeGridElement(int x, int y);
         void placeGridElement(std::shared_ptr<Entity> entity, int x, int y);
         void moveGridElement(int startX, int startY, int endX, int endY);
 
-        // level reset
-        void reset(MemSwap * game);
+        void setVanished(Entity * entity, bool vanished);
+        void setLastPortal(Player * player, Portal * portal);
 
-        void placePortals();
+        void removePortals();
+        bool placePortals();
+        bool portalsRemoved() const;
 
         // check for level completion
         bool checkComplete();
@@ -80,16 +139,30 @@ class Level {
         int getMovesUndone() const;
 
         template <class T>
-        std::shared_ptr<T> getGridElement(int x, int y) const {
+        T * getGridElement(int x, int y) const {
             return map.getGridElement<T>(x, y);
         }
 
-        void playSound(std::string soundID) const;
+        void addEvent(const SimEvent & event);
+        const std::vector<SimEvent> & getEvents() const;
 
         bool inBounds(int x, int y) const;
         Parity getTileParity(int x, int y) const;
 
-        std::shared_ptr<Player> getPlayer() const;
+        Player * getPlayer() const;
+
+        // Zobrist hash of the current state: the map's (see Map::getHash),
+        // vanished entities and the player's last portal
+        uint64_t getHash() const {
+            return map.getHash() ^ entityHash;
+        }
+
+        // number of moves that can be undone
+        int getUndoCount() const;
+        const UndoLog & getUndoLog() const;
+
+        const Map & getMap() const;
+        const std::string & getMapPath() const;
 };
 
-#endif // LEVEL_HPP
\ No newline at end of file
+#endif // LEVEL_HPP
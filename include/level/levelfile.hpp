@@ -0,0 +1,59 @@
+// Binary (compiled) level format
+//
+// A .lvl file is a map with its tile parities, entity kinds and properties
+// resolved from the tilesets ahead of time (see tools/compilemaps.cpp), laid
+// out to be read straight from a memory mapped file:
+//
+//   LevelFileHeader
+//   LevelFileTileset[tilesetCount]
+//   LevelFileEntity[entityCount]     (in entity ID order)
+//   int32_t tileGIDs[tileCount]
+//   uint8_t tileParities[tileCount]
+//
+// Fields are little endian, as written by the compiler on the same platform.
+
+#ifndef LEVELFILE_HPP
+#define LEVELFILE_HPP
+
+#include <cstdint>
+
+inline const char LEVEL_FILE_MAGIC[4] = {'P', 'P', 'L', 'V'};
+
+// bump when the layout changes (old files are rejected, not converted)
+inline const uint32_t LEVEL_FILE_VERSION = 1;
+
+struct LevelFileHeader {
+    char magic[4];
+    uint32_t version;
+
+    int32_t width, height;              // in tiles
+    int32_t tileWidth, tileHeight;      // in pixels
+
+    // number of background tiles (width * height, or 0 with no bg layer)
+    int32_t tileCount;
+
+    int32_t tilesetCount;
+    int32_t entityCount;
+    int32_t reserved;
+};
+
+struct LevelFileTileset {
+    int32_t firstGID;
+    char name[28];                      // null terminated
+};
+
+struct LevelFileEntity {
+    int16_t gridX, gridY;
+    uint8_t kind;                       // EntityKind
+    uint8_t parity;
+    int8_t power;                       // boosts
+    int8_t direction;                   // boosts
+    int32_t tileGID;
+    char shape[20];                     // receptors, null terminated
+};
+
+static_assert(sizeof(LevelFileHeader) == 40, "unexpected level file header size");
+static_assert(sizeof(LevelFileTileset) == 32, "unexpected level file tileset size");
+static_assert(sizeof(LevelFileEntity) == 32, "unexpected level file entity size");
+
+#endif // LEVELFILE_HPP
@@ -0,0 +1,39 @@
+// Background loading of the next level
+
+#ifndef LEVELLOADER_HPP
+#define LEVELLOADER_HPP
+
+#include <future>
+#include <string>
+
+#include "level/level.hpp"
+
+// Loads a level (parsing its map and constructing its entities) on a worker
+// thread, so it's ready to swap in when it's needed. Only the level itself is
+// built off the main thread; its view (and anything else touching SDL) is
+// built on hand-off.
+class LevelLoader {
+    private:
+        // path of the level being prefetched ("" if none) and its result. An
+        // unclaimed prefetch is waited on when it's replaced (or the loader is
+        // destroyed), so it can't outlive the loader
+        std::string prefetchPath;
+        std::future<Level> prefetched;
+
+    public:
+        LevelLoader();
+
+        LevelLoader(const LevelLoader &) = delete;
+        LevelLoader & operator=(const LevelLoader &) = delete;
+
+        // start loading the level at the given path (unless it's already
+        // being prefetched)
+        void prefetch(const std::string & path);
+
+        // take the prefetched level if it's the one at the given path,
+        // waiting for it to finish loading. Returns false (leaving level
+        // untouched) if it wasn't prefetched
+        bool take(const std::string & path, Level & level);
+};
+
+#endif // LEVELLOADER_HPP
@@ -7,45 +7,66 @@
 #include <memory>
 #include <vector>
 #include <string>
-#include <unordered_map>
-#include <list>
+#include <map>
 
-#include <SDL.h>
-#include <SDL_image.h>
 #include <tmxlite/Map.hpp>
 #include <tmxlite/Layer.hpp>
 #include <tmxlite/TileLayer.hpp>
 
 #include "entities/entity.hpp"
 #include "entities/portal.hpp"
-#include "level/tile.hpp"
-#include "utils/spritesheet.hpp"
-#include "utils/sprite.hpp"
-
-class MemSwap;
+#include "level/parityplane.hpp"
+#include "level/zobrist.hpp"
+#include "utils/tileproperties.hpp"
 
 class Level;
+class Player;
+
+// a cell of the entity grid: kind and ID of the entity in it
+struct GridCell {
+    EntityKind kind;
+    int entityID;
+};
+
+// mutable state of a map, stored for undo
+struct MapState {
+    ParityPlane tileParities;
+    std::vector<EntityState> entityStates;
+    bool portalsRemoved;
+};
 
 class Map {
     private:
-        int mapWidth, mapHeight;         // size of map in tiles
-        int tileWidth, tileHeight;       // size of tiles in pixels
+        int mapWidth = 0, mapHeight = 0;         // size of map in tiles
+        int tileWidth = 0, tileHeight = 0;       // size of tiles in pixels
+
+        bool usesPortals = false;
 
-        int renderX, renderY;            // x,y on the screen to render map
+        // if the portals are temporarily lifted from the grid
+        bool portalsRemoved = false;
 
-        bool usesPortals;
+        // parities of the background tiles, indexed by xyToIndex
+        ParityPlane tileParities;
 
-        // A vector holding the background tiles for the map
-        std::vector<Tile> mapTiles;
+        // GIDs of the background tiles
+        std::vector<int> tileGIDs;
 
-        // A map holding the entities in the grid, key = index, value = ptr
-        std::unordered_map<int, std::shared_ptr<Entity>> entityGrid;
+        // kind/ID of the entity in each grid cell (NO_ENTITY if empty),
+        // indexed by xyToIndex
+        std::vector<GridCell> entityGrid;
 
-        // store spritesheets used by this map  (key: ss first GID, val: ptr->ss)
-        std::unordered_map<int, std::shared_ptr<SpriteSheet>> mapSpritesheets;
+        // Zobrist hash of the occupied grid cells (the tiles' hash is kept by
+        // tileParities)
+        uint64_t gridHash = 0;
 
-        // store tile sprites for parity tiles (key: parity, val: sprite ptr)
-        std::unordered_map<int, std::shared_ptr<Sprite>> parityTileSprites;
+        // all entities in the map, indexed by entity ID, and their tile GIDs
+        std::vector<std::shared_ptr<Entity>> mapEntities;
+        std::vector<int> entityGIDs;
+
+        // tile properties/names of the tilesets used by this map (key: first
+        // GID). Properties are only read when loading a tiledmap
+        std::map<int, TileProperties> tilesetProperties;
+        std::map<int, std::string> tilesetNames;
 
         // track the portals in the map
         std::vector<std::shared_ptr<Portal>> mapPortals;
@@ -69,55 +90,83 @@ class Map {
         inline const static std::string DIAMOND_ENAME = "diamond";
         inline const static std::string PORTAL_ENAME = "portal";
 
-        inline const static std::string FLIP_SOUND_ID = "flip";
+        inline const static std::string TILED_MAP_EXT = ".tmx";
+        inline const static std::string COMPILED_MAP_EXT = ".lvl";
+
+        // set a grid cell, updating the hash
+        void setGridCell(int index, GridCell cell) {
+            GridCell & oldCell = entityGrid[index];
+            gridHash ^= zobristCellKey(index, oldCell.kind) ^ zobristCellKey(index, cell.kind);
+            oldCell = cell;
+        }
 
     public:
+        inline const static int NO_ENTITY = -1;
+        inline const static int PORTALS_REMOVED_FLAG = 0;
+
         Map();
-        Map(std::string tiledMapPath, SDL_Renderer * renderer, Level * level, 
-            MemSwap * game);
+        Map(std::string tiledMapPath, Level * level);
 
-        void handleEvents(Level * level, const Uint8 * keyStates);
-        void update(Level * level, float delta);
-        void render(SDL_Renderer * renderer) const;
+        // create an empty map of the given size, with all tiles gray
+        void initMap(int width, int height, int tileWidth, int tileHeight);
 
         // reset/clear the map
         void clear();
 
-        // Load map for the level
-        void loadMap(std::string tiledMapPath, SDL_Renderer * renderer, 
-            Level * level, MemSwap * game);
+        // Load map for the level, from a tiledmap (.tmx) or a compiled level
+        // (.lvl, see level/levelfile.hpp)
+        void loadMap(std::string mapPath, Level * level);
+        void loadTiledMap(std::string tiledMapPath, Level * level);
+        bool loadCompiledMap(std::string compiledMapPath, Level * level);
+
+        // write the map as loaded to a compiled level, for loadCompiledMap
+        bool saveCompiledMap(std::string compiledMapPath) const;
 
-        // add background tiles to the map from the given tileLayer
-        void addTiles(const tmx::TileLayer * tileLayer, Level * level,
-            MemSwap * game, std::string layerName);
+        // add background tiles/entities to the map from the given tileLayer
+        void addTiles(const tmx::TileLayer * tileLayer, std::string layerName);
 
-        void addBGTile(int screenX, int screenY, int tileID, 
-            const std::shared_ptr<SpriteSheet> & spritesheet, MemSwap * game);
-        void addEntity(int screenX, int screenY, int gridX, int gridY, int tileID, 
-            const std::shared_ptr<SpriteSheet> & spritesheet, MemSwap * game);   
+        void addBGTile(int tileGID);
+        void addEntity(int gridX, int gridY, int tileGID);
+        void addEntity(std::shared_ptr<Entity> entity, int tileGID = 0);
+        void addPortal(std::shared_ptr<Portal> portal, int tileGID);
 
         void initGrid();
 
         // Check if a tile is in bounds
-        bool inBounds(int x, int y) const;
+        bool inBounds(int x, int y) const {
+            return (x >= 0 && x <= mapWidth - 1) && (y >= 0 && y <= mapHeight - 1);
+        }
 
         // Update bg tiles when the specified movement occurs
-        void flipTile(int tileX, int tileY, int entityParity, Level * level, 
-            bool undo = false);
+        void flipTile(int tileX, int tileY, int entityParity, Level * level);
 
-        // Get parity of tile at the specified grid location
-        Parity getTileParity(int x, int y) const;
+        // Get/set parity of tile at the specified grid location
+        Parity getTileParity(int x, int y) const {
+            return inBounds(x, y) ? tileParities.get(xyToIndex(x, y)) : PARITY_NONE;
+        }
+        void setTileParity(int x, int y, Parity parity);
+
+        // if every tile is purple (level complete)
+        bool allTilesPurple() const;
+        const ParityPlane & getTileParities() const;
 
-        // check for a particular entity shared_ptr at the given tile
+        // check for a particular type of entity at the given tile, returns a
+        // (non-owning) pointer to it or nullptr
         template <class T>
-        std::shared_ptr<T> getGridElement(int x, int y) const {
-            std::shared_ptr<T> gridElement = nullptr;
+        T * getGridElement(int x, int y) const {
             if(inBounds(x, y)) {
-                gridElement = std::dynamic_pointer_cast<T>(
-                    entityGrid.at(xyToIndex(x, y)));
+                const GridCell & cell = entityGrid[xyToIndex(x, y)];
+                if(T::isKind(cell.kind)) {
+                    return static_cast<T *>(mapEntities[cell.entityID].get());
+                }
             }
 
-            return gridElement;
+            return nullptr;
+        }
+
+        // entity ID of the entity at the given tile (NO_ENTITY if none)
+        int getGridEntityID(int x, int y) const {
+            return inBounds(x, y) ? entityGrid[xyToIndex(x, y)].entityID : NO_ENTITY;
         }
 
         // functions for modifying grid elements
@@ -125,18 +174,47 @@ class Map {
         void placeGridElement(std::shared_ptr<Entity> entity, int x, int y);
         void removeGridElement(int x, int y);
 
-        void placePortals();
+        // temporarily lift portals from grid/place them back if unoccupied
+        void removePortals();
+        bool placePortals();
+        bool arePortalsRemoved() const;
+
+        // store/restore the mutable state of the map
+        void saveState(MapState & state) const;
+        void loadState(const MapState & state);
+
+        // if the map is in the given state
+        bool matchesState(const MapState & state) const;
 
-        int getRenderX() const;
-        int getRenderY() const;
+        // Zobrist hash of the tile parities, entity kinds/positions in the
+        // grid and the portals being lifted, kept up to date on every change
+        uint64_t getHash() const {
+            return tileParities.getHash() ^ gridHash ^
+                (portalsRemoved ? zobristFlagKey(PORTALS_REMOVED_FLAG) : 0);
+        }
+
+        int getWidth() const;
+        int getHeight() const;
+        int getTileWidth() const;
+        int getTileHeight() const;
         bool hasPortals() const;
 
         // functions to convert between x,y indices to map key
-        int xyToIndex(int x, int y) const;
+        int xyToIndex(int x, int y) const {
+            return x + y * mapWidth;
+        }
         std::pair<int, int> indexToXY(int index) const;
 
-        std::shared_ptr<Player> getPlayer() const;
-        int getMovesUndone() const;
+        // get tileset's firstGID for a tile GID (greatest first GID <= it)
+        int getTilesetFirstGID(int tileGID) const;
+        const std::string & getTilesetName(int firstGID) const;
+
+        int getTileGID(int x, int y) const;
+        int getEntityGID(int entityID) const;
+
+        const std::vector<std::shared_ptr<Entity>> & getEntities() const;
+        // the player (non-owning, nullptr if the map has none)
+        Player * getPlayer() const;
 };
 
-#endif // MAP_HPP
\ No newline at end of file
+#endif // MAP_HPP
@@ -0,0 +1,84 @@
+// Packed bit planes of the background tile parities of a map
+
+#ifndef PARITYPLANE_HPP
+#define PARITYPLANE_HPP
+
+#include <cstdint>
+#include <vector>
+
+#include "entities/entity.hpp"
+#include "level/zobrist.hpp"
+
+// Each tile is one bit in the gray plane and one in the purple plane (neither
+// set ~ parity-neutral). Keeps a running count of non-purple tiles so level
+// completion can be checked in O(1), and a running Zobrist hash of the
+// tiles' parities (see level/zobrist.hpp).
+class ParityPlane {
+    private:
+        int size = 0;
+
+        // tiles per word
+        inline const static int WORD_BITS = 64;
+
+        std::vector<uint64_t> grayBits;
+        std::vector<uint64_t> purpleBits;
+
+        // how many tiles aren't purple (gray or neutral)
+        int nonPurpleCount = 0;
+
+        uint64_t hash = 0;
+
+    public:
+        // resize to the given number of tiles, all of the given parity
+        void assign(int size, Parity parity);
+        void clear();
+
+        // append a tile with the given parity
+        void push(Parity parity);
+
+        Parity get(int index) const {
+            uint64_t mask = uint64_t(1) << (index % WORD_BITS);
+            int word = index / WORD_BITS;
+
+            if(purpleBits[word] & mask) return PARITY_PURPLE;
+            if(grayBits[word] & mask) return PARITY_GRAY;
+            return PARITY_NONE;
+        }
+
+        void set(int index, Parity parity) {
+            uint64_t mask = uint64_t(1) << (index % WORD_BITS);
+            int word = index / WORD_BITS;
+
+            bool wasPurple = purpleBits[word] & mask;
+            nonPurpleCount += wasPurple - (parity == PARITY_PURPLE);
+            hash ^= zobristTileKey(index, get(index)) ^ zobristTileKey(index, parity);
+
+            grayBits[word] = parity == PARITY_GRAY ? grayBits[word] | mask : grayBits[word] & ~mask;
+            purpleBits[word] = parity == PARITY_PURPLE ? purpleBits[word] | mask : purpleBits[word] & ~mask;
+        }
+
+        // overwrite which tiles are purple from a packed plane of the same
+        // size; non-purple tiles become gray, neutral tiles stay neutral
+        void setPurpleBits(const uint64_t * words);
+
+        // number of tiles with the given parity (popcount over the planes)
+        int count(Parity parity) const;
+
+        uint64_t getHash() const {
+            return hash;
+        }
+
+        int getNonPurpleCount() const;
+        bool isAllPurple() const;
+        int getSize() const;
+        int getWordCount() const;
+
+        // the raw planes, eg for hashing
+        const std::vector<uint64_t> & getGrayBits() const;
+        const std::vector<uint64_t> & getPurpleBits() const;
+
+        bool operator==(const ParityPlane & other) const;
+        bool operator!=(const ParityPlane & other) const;
+};
+
+#endif // PARITYPLANE_HPP
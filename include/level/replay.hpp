@@ -0,0 +1,114 @@
+// Recorded play of a level, for deterministic playback
+//
+// A replay holds the keys held on each tick the play state read input (run
+// length encoded), the simulation inputs they led to, and the hash of the
+// level's final state. In game, the keys are fed back in place of the
+// keyboard, reproducing the view's timing as well. Headless, the simulation
+// inputs are applied straight to the level (see verify), much faster than
+// real time.
+//
+// A .rpl file is laid out as:
+//
+//   ReplayFileHeader
+//   ReplayKeyRun[runCount]
+//   uint8_t steps[stepCount]         (SimInput)
+//
+// Fields are little endian, as with level files (see levelfile.hpp).
+
+#ifndef REPLAY_HPP
+#define REPLAY_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "level/simevent.hpp"
+
+class Level;
+
+inline const char REPLAY_FILE_MAGIC[4] = {'P', 'P', 'R', 'P'};
+
+// bump when the layout changes (old files are rejected)
+inline const uint32_t REPLAY_FILE_VERSION = 1;
+
+// keys read by the play state, as flags
+enum ReplayKey : uint8_t {
+    REPLAY_KEY_UP       = 1 << 0,       // w
+    REPLAY_KEY_DOWN     = 1 << 1,       // s
+    REPLAY_KEY_LEFT     = 1 << 2,       // a
+    REPLAY_KEY_RIGHT    = 1 << 3,       // d
+    REPLAY_KEY_UNDO     = 1 << 4,       // u
+    REPLAY_KEY_RESET    = 1 << 5,       // r
+    REPLAY_KEY_PAUSE    = 1 << 6,       // escape
+    REPLAY_KEY_HINT     = 1 << 7        // h
+};
+
+struct ReplayFileHeader {
+    char magic[4];
+    uint32_t version;
+
+    char levelID[16];                   // null terminated
+
+    uint32_t tickCount;
+    uint32_t runCount;
+    uint32_t stepCount;
+    uint32_t reserved;
+
+    uint64_t finalHash;
+};
+
+// the same keys held for a number of ticks
+struct ReplayKeyRun {
+    uint16_t ticks;
+    uint8_t keys;
+    uint8_t reserved;
+};
+
+static_assert(sizeof(ReplayFileHeader) == 48, "unexpected replay file header size");
+static_assert(sizeof(ReplayKeyRun) == 4, "unexpected replay key run size");
+
+class Replay {
+    private:
+        std::string levelID;
+
+        std::vector<ReplayKeyRun> keyRuns;
+        std::vector<uint8_t> steps;
+
+        uint32_t tickCount = 0;
+        uint64_t finalHash = 0;
+
+        // playback position: run, and ticks played of it
+        unsigned int playbackRun = 0;
+        int playbackTicks = 0;
+
+    public:
+        Replay();
+        Replay(const std::string & levelID);
+
+        // record the keys held on a tick/a simulation input stepped (see
+        // Level::setRecorder)/the level's final state
+        void recordTick(uint8_t keys);
+        void recordStep(SimInput input);
+        void finish(uint64_t finalHash);
+
+        bool save(const std::string & path) const;
+        bool load(const std::string & path);
+
+        // get the keys of the next tick played back, false once all are played
+        bool nextKeys(uint8_t & keys);
+
+        // step the level (as loaded) through the recorded simulation inputs,
+        // returns true if it ends in the recorded final state
+        bool verify(Level & level) const;
+
+        // index of the first simulation input that differs from the other
+        // replay's (-1 if none)
+        int firstDifference(const Replay & other) const;
+
+        const std::string & getLevelID() const;
+        const std::vector<uint8_t> & getSteps() const;
+        uint32_t getTickCount() const;
+        uint64_t getFinalHash() const;
+};
+
+#endif // REPLAY_HPP
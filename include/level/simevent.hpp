@@ -0,0 +1,43 @@
+// Inputs and output events of the level simulation
+
+#ifndef SIMEVENT_HPP
+#define SIMEVENT_HPP
+
+// inputs which advance the simulation by one step
+enum SimInput {
+    INPUT_NONE,
+    INPUT_UP,
+    INPUT_DOWN,
+    INPUT_LEFT,
+    INPUT_RIGHT,
+    INPUT_UNDO,
+    INPUT_RESET
+};
+
+// events produced by a simulation step, in the order they occurred
+enum SimEventType {
+    EVENT_MOVE,         // entity moved from (x,y) to (toX,toY)
+    EVENT_FLIP,         // tile (x,y) flipped to parity 'value'
+    EVENT_BOOST,        // entity picked up boost 'otherID' at (x,y), sending it
+                        // from (toX,toY) (its own tile if it bumped the boost)
+    EVENT_MERGE,        // entity merged with receptor 'otherID' at (x,y)
+    EVENT_TELEPORT,     // entity teleported from portal 'otherID' at (x,y) to (toX,toY)
+    EVENT_VANISH,       // portal at (x,y) vanished
+    EVENT_BONK,         // entity failed to move in direction 'value'
+    EVENT_COMPLETE      // level was completed
+};
+
+struct SimEvent {
+    SimEventType type;
+
+    // entity the event happened to, and the other entity involved (or -1)
+    int entityID;
+    int otherID;
+
+    int x, y;
+    int toX, toY;
+
+    int value;
+};
+
+#endif // SIMEVENT_HPP
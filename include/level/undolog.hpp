@@ -0,0 +1,99 @@
+// Level-wide log of changes to the simulation state, for undo
+
+#ifndef UNDOLOG_HPP
+#define UNDOLOG_HPP
+
+#include <cstdint>
+#include <vector>
+
+enum UndoType : uint8_t {
+    UNDO_STEP,          // start of a move
+    UNDO_FLIP,          // tile flipped
+    UNDO_MOVE,          // entity moved in the grid (incl. teleports)
+    UNDO_CELL,          // grid cell set/cleared (boost consumed, receptor merged)
+    UNDO_VANISH,        // entity vanished (boost consumed, merged, portal closed)
+    UNDO_LINK,          // player's last portal changed (teleport)
+    UNDO_PORTALS        // portals lifted from/placed back in the grid
+};
+
+// a single change, holding what's needed to reverse it
+struct UndoRecord {
+    UndoType type;
+
+    // previous tile parity/vanished flag/portals lifted flag
+    uint8_t value;
+
+    // entity vanished/relinked, or the previous entity in a cell (-1 ~ none)
+    int32_t entityID;
+
+    // tile/cell index (moves: the cell moved from), or the previous link
+    int32_t index;
+
+    // moves: cell moved to, steps: hash of the level state before the move
+    uint64_t data;
+};
+
+// Fixed size ring buffer of records, allocated once. Each move starts with an
+// UNDO_STEP record followed by its changes, so undoing a move pops records
+// back to its step. Once full, the oldest moves are dropped to make room.
+class UndoLog {
+    private:
+        std::vector<UndoRecord> records;
+
+        // records in the log are [start, end), indexed mod records.size()
+        uint64_t start = 0, end = 0;
+
+        // number of UNDO_STEP records in the log
+        int steps = 0;
+
+        // drop the oldest move
+        void dropStep();
+
+    public:
+        inline const static int DEFAULT_CAPACITY = 1 << 16;
+
+        UndoLog(int capacity = DEFAULT_CAPACITY);
+
+        void clear();
+
+        // begin a move from a state with the given hash/log one of its changes
+        void beginStep(uint64_t hash);
+        void push(const UndoRecord & record) {
+            if(end - start == records.size()) dropStep();
+
+            records[end++ % records.size()] = record;
+        }
+
+        // take the last record (the log must not be empty)
+        UndoRecord pop() {
+            UndoRecord & record = records[--end % records.size()];
+            if(record.type == UNDO_STEP) steps--;
+
+            return record;
+        }
+
+        // fold the last move's records into the move before it (eg. for a
+        // failed move that still changed some state). A move without records
+        // is dropped, and the first move in the log is kept as is
+        void mergeStep();
+
+        // find the earliest move that started from a state with the given
+        // hash, returns false if there's none
+        bool findStep(uint64_t hash, uint64_t & position) const;
+
+        // drop the records from the given position on
+        void truncate(uint64_t position);
+
+        // a record by position (as found by findStep), positions in the log
+        // run up to getEnd()
+        const UndoRecord & getRecord(uint64_t position) const {
+            return records[position % records.size()];
+        }
+        uint64_t getEnd() const;
+
+        int getStepCount() const;
+        int getRecordCount() const;
+        int getCapacity() const;
+};
+
+#endif // UNDOLOG_HPP
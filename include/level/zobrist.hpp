@@ -0,0 +1,37 @@
+// Zobrist keys for hashing map states
+
+#ifndef ZOBRIST_HPP
+#define ZOBRIST_HPP
+
+#include <cstdint>
+
+#include "entities/entity.hpp"
+
+// A map's hash is the XOR of a key for each (tile, parity) and each (cell,
+// entity kind) in it, so a change to a single tile/cell updates it in O(1).
+// Keys are computed (splitmix64 of the key's index) rather than looked up in
+// a table, so they don't depend on map size and hashes are the same across
+// runs/builds.
+inline uint64_t zobristKey(uint64_t index) {
+    uint64_t z = index + 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// key of a gray/purple tile (neutral tiles don't contribute)
+inline uint64_t zobristTileKey(int index, Parity parity) {
+    return parity == PARITY_NONE ? 0 : zobristKey(uint64_t(index) * 8 + parity);
+}
+
+// key of a grid cell holding an entity of the given kind
+inline uint64_t zobristCellKey(int index, EntityKind kind) {
+    return kind == ENTITY_NONE ? 0 : zobristKey(uint64_t(index) * 8 + 2 + kind);
+}
+
+// key of other (single bit) parts of a state, eg. portals being lifted
+inline uint64_t zobristFlagKey(int flag) {
+    return zobristKey(~uint64_t(flag));
+}
+
+#endif // ZOBRIST_HPP
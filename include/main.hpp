@@ -5,4 +5,14 @@
 
 #include <stdio.h>
 
+// command line flags (see main.cpp)
+const char STARTUP_BENCH_ARG[] = "-startup-bench";
+const char RENDER_STATS_ARG[] = "-render-stats";
+const char NO_ATLAS_ARG[] = "-no-atlas";
+const char NO_BATCH_ARG[] = "-no-batch";
+const char RECORD_ARG[] = "-record";
+const char REPLAY_ARG[] = "-replay";
+
+const int RENDER_STATS_FRAMES = 60;
+
 #endif // MAIN_HPP
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <string>
 #include <stdio.h>
 #include <array>
+#include <functional>
 
 #include <SDL.h>
 #include <SDL_image.h>
@@ -15,8 +16,13 @@
 
 #include "gameStates/gamestate.hpp"
 
+#include "gui/perfoverlay.hpp"
+
 #include "utils/resmanager.hpp"
 #include "utils/profile.hpp"
+#include "utils/screenfade.hpp"
+
+#include "level/replay.hpp"
 
 class MemSwap {
     private:
@@ -24,6 +30,16 @@ class MemSwap {
         float delta = 0;        // ms passed since last call to update
         Uint64 lastTime = 0;    // last call to update
         Uint64 currTime;        // curr call to update
+        Uint64 lastPresentTime = 0; // last frame rendered to the screen
+
+        // the states are updated in fixed ticks of TICK_MS (so runs don't
+        // depend on the frame rate), consuming the time accumulated since the
+        // last tick. Frames are rendered tickAlpha of the way into the next tick
+        float accumulator = 0;
+        float tickAlpha = 1.f;
+
+        // longest frame simulated, so a stall doesn't snowball into more ticks
+        const float MAX_FRAME_MS = 250.f;
 
         // when play state was last started (reset each time enter)
         Uint64 startPlayTime = 0;  
@@ -45,7 +61,11 @@ class MemSwap {
 
         const std::string GAME_TITLE = "Purple Puzzles";
         const std::string RES_PATHS_FILE = "res/res_paths.json";
-        const std::string ICON_ID = "window_icon";
+
+        // where/how much of the profile is written (see utils/profiler.hpp)
+        const std::string PROFILE_PATH = "profile.json";
+        const double PROFILE_DUMP_SECONDS = 10.0;
+        const ResId ICON_ID = RES_WINDOW_ICON;
         const std::string SAVE_PATH = "res/saves/playerSave.data";
 
         const std::string CREDITS_STRING = "Purple Puzzles\n\n"
@@ -68,6 +88,22 @@ class MemSwap {
 
         bool minimized = false;
         bool fullscreen = false; // Press F11 to toggle fullscreen
+
+        // frames are only rendered when something may have changed: after
+        // input/a state change, or while the current state isn't idle. With
+        // nothing to render, the loop waits for input instead of spinning
+        bool redraw = true;         // input/state change since the last update
+        bool renderFrame = true;    // if the current frame is rendered
+        bool stateIdle = false;     // if the state was idle last update
+
+        // ms to wait for input when idle/minimized (waking up periodically),
+        // or between frames while a key is held down (input is read per frame)
+        const int IDLE_WAIT_MS = 250;
+        const int FRAME_WAIT_MS = 16;
+
+        // times the contents of render target textures were lost (eg. the
+        // D3D device was reset), so cached renders know to redraw
+        int renderResets = 0;
         
         SDL_Window * window;
         SDL_Renderer * renderer;
@@ -90,6 +126,20 @@ class MemSwap {
         // Resource manager for the game
         ResManager resourceManager;
 
+        // fade between states/levels
+        ScreenFade screenFade;
+
+        // frame timing/render stats (F3), and where the frame times are saved
+        // on exit (if it was shown)
+        PerfOverlay perfOverlay;
+        const std::string FRAME_TIMES_PATH = "frametimes.txt";
+        const ResId OVERLAY_FONT_ID = RES_MAIN_FONT;
+
+        // directory levels played are recorded to ("" if not recording), and
+        // the replay being played back (if any)
+        std::string recordDir;
+        std::shared_ptr<Replay> playback;
+
         // Player data/profile
         Profile playerProfile;
         
@@ -97,12 +147,21 @@ class MemSwap {
         SDL_Renderer * init();
         bool initLibs();
 
+        bool keyHeld() const;
+
+        // advance the current state by a tick
+        void tick();
+
         // state management
         void changeState();
+        void switchState();
         void addGameState(GameStateID gameStateID, std::unique_ptr<GameState> & state);
         void removeGameState(GameStateID gameStateID);
 
     public:
+        // ms simulated per tick
+        inline const static float TICK_MS = 1000.f / 60.f;
+
         /// Constructor
         MemSwap();
 
@@ -123,14 +182,28 @@ class MemSwap {
         void update();
 
         /// Render the current state of the game
-        void render() const;
+        void render();
 
-        // play the specified sound
-        void playSound(std::string soundID) const;
+        // play the specified sound (by handle, resolved once, on hot paths)
+        void playSound(ResId soundID) const;
+        void playSound(SoundHandle sound) const;
 
         // Manage game states
         void setNextState(GameStateID gameID);
 
+        // record levels played to replays in the given directory
+        void setRecordDir(const std::string & dir);
+        std::string getRecordDir() const;
+
+        // play back the given replay (going straight to its level), returns
+        // false if it couldn't be loaded
+        bool startPlayback(const std::string & path);
+        std::shared_ptr<Replay> getPlayback() const;
+
+        // fade the screen out, calling onFaded once it's black, then back in
+        void startFade(std::function<void()> onFaded);
+        bool isFading() const;
+
         void quit();
 
         int indexOfLevelID(std::string ID) const;
@@ -140,6 +213,8 @@ class MemSwap {
         GameStateID getGameStateID() const;
         SDL_Event getEvent() const;
         SDL_Renderer * getRenderer() const;
+        float getTickAlpha() const;
+        int getRenderResets() const;
 
         SDL_Color getOutlineColor() const;
         SDL_Color getButtonTextColor() const;
@@ -152,6 +227,7 @@ class MemSwap {
 
         // manage current level in the game
         bool advanceLevel();
+        std::string getNextLevelID() const;
         void setCurrLevelID(std::string levelID);
 
         void setCurrMenuScreen(int screenID);
@@ -167,7 +243,9 @@ class MemSwap {
         void setPaused(bool paused);
         bool isPaused() const;
 
-        void loadNextResource();
+        // start loading resources in the background/store a batch of loaded ones
+        void startLoadingResources();
+        void uploadLoadedResources();
         const ResManager & getResManager();
 };
 
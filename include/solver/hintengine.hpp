@@ -0,0 +1,97 @@
+// Background solver for in-game hints
+
+#ifndef HINTENGINE_HPP
+#define HINTENGINE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "level/level.hpp"
+#include "solver/solver.hpp"
+
+struct Hint {
+    // hash of the level state the hint was asked for
+    uint64_t stateHash = 0;
+
+    // first move of a shortest solution (INPUT_NONE if there's none)
+    SimInput move = INPUT_NONE;
+
+    // if the level can't be completed from the state (searched exhaustively)
+    bool unsolvable = false;
+
+    // if the search hit the memory cap before finding a solution (so it's
+    // unknown whether there's one)
+    bool capped = false;
+
+    // time from the request to the result, in ms
+    double latency = 0.0;
+};
+
+// Solves the level from a snapshot of the player's state on a background
+// thread, so the game never waits on it. A new request (or cancel) stops the
+// search in progress; results are picked up with poll().
+class HintEngine {
+    private:
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable wake;
+
+        // pending request, taken by the thread
+        bool requested = false;
+        std::string requestPath;
+        MapState requestState;
+        uint64_t requestHash = 0;
+        std::chrono::steady_clock::time_point requestTime;
+
+        // finished result, taken by poll()
+        bool hintReady = false;
+        Hint hint;
+
+        bool searching = false;
+        bool quitting = false;
+
+        // stops the search in progress
+        std::atomic<bool> cancelling;
+
+        // solver for the last level searched (kept to skip reloading it)
+        std::unique_ptr<Solver> solver;
+        std::string solverPath;
+
+        // hints are searched with a quarter of the system's memory, within
+        // these bounds (at most the solver's default in a 32-bit build)
+        size_t memoryCap;
+        inline const static size_t MIN_MEMORY_CAP = size_t(256) << 20;
+        inline const static size_t MAX_MEMORY_CAP = sizeof(void *) >= 8 ?
+            size_t(1) << 30 : Solver::DEFAULT_MEMORY_CAP;
+
+        void run();
+
+    public:
+        // given the system's memory in bytes (0 if unknown)
+        HintEngine(size_t systemMemory = 0);
+        ~HintEngine();
+
+        HintEngine(const HintEngine &) = delete;
+        HintEngine & operator=(const HintEngine &) = delete;
+
+        // start searching from the level's current state (cancelling any
+        // search in progress)
+        void request(const Level & level);
+
+        // stop the search in progress and drop any unclaimed result
+        void cancel();
+
+        // take the result of the last request, if it's finished
+        bool poll(Hint & hint);
+
+        // if a request is pending or being searched
+        bool isSearching();
+};
+
+#endif // HINTENGINE_HPP
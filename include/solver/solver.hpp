@@ -0,0 +1,225 @@
+// Shortest-solution search over the headless level simulation
+//
+// The simulation resolves a whole move at once, so a pushed diamond slides to
+// the end of its boosts as part of the push. In the original real-time game
+// it slid at half the player's speed, and the player could walk into its path
+// to stop it early; levels built around that (eg. 2-2) are unsolvable here.
+
+#ifndef SOLVER_HPP
+#define SOLVER_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "level/level.hpp"
+#include "solver/statetable.hpp"
+
+struct SolverResult {
+    // if a solution was found
+    bool solved = false;
+
+    // if the search ran to completion without hitting the memory cap (an
+    // exhausted search without a solution proves the level unsolvable)
+    bool exhausted = false;
+
+    // if the search was cancelled before finishing
+    bool cancelled = false;
+
+    // shortest sequence of inputs which completes the level
+    std::vector<SimInput> moves;
+
+    int threads = 1;
+    long long statesExpanded = 0;
+    long long statesStored = 0;
+    size_t peakMemory = 0;
+    double seconds = 0.0;
+    double statesPerSecond = 0.0;
+};
+
+// a node waiting to be expanded, with the moves it was reached in
+struct SolverWork {
+    uint32_t nodeID;
+    uint16_t g;
+};
+
+// what a part of the gray tiles holds, for cut cell checks
+struct SolverCutCounts {
+    int movables = 0;
+    int leaving = 0;        // movables on gray tiles, which have to merge
+    int receptors = 0;
+    int cover = 0;          // gray tiles that have to be left
+
+    void add(const SolverCutCounts & other, int sign = 1) {
+        movables += sign * other.movables;
+        leaving += sign * other.leaving;
+        receptors += sign * other.receptors;
+        cover += sign * other.cover;
+    }
+};
+
+// a cell during the search for cut cells, with the counts of its DFS subtree
+// and of the subtrees cut off without it
+struct SolverCutCell {
+    int order;
+    int low;
+    int parent;
+    uint8_t next;
+    bool parentSkipped;
+
+    SolverCutCounts subtree;
+    SolverCutCounts cut;
+
+    // cut off parts that need a movable to pass through the cell
+    int stranded;               // tiles to cover, but no movable
+    int strandedNoReceptor;     // ... nor a receptor to end on
+    int exits;                  // movables with no receptor to end on
+};
+
+// a search thread's own copy of the level, scratch space and work queue
+struct SolverWorker {
+    Level level;
+
+    // states of the level at the start, and scratch space for decoding
+    MapState initialState;
+    MapState scratchState;
+    std::vector<uint64_t> scratchWords;
+    std::vector<uint8_t> state;
+    std::vector<uint8_t> childState;
+
+    // scratch space for dead state checks
+    std::vector<uint8_t> cellFlags;
+    std::vector<int> cellQueue;
+    std::vector<SolverCutCell> cutCells;
+    std::vector<int> cutOrder;
+
+    // nodes in the current f layer, popped from the back by the owner and
+    // stolen from the front by idle threads
+    std::mutex queueMutex;
+    std::deque<SolverWork> queue;
+
+    // nodes found for later f layers, by f
+    std::vector<std::vector<SolverWork>> later;
+
+    long long statesExpanded = 0;
+
+    SolverWorker(std::string tiledMapPath);
+};
+
+// A* search for the fewest moves that complete a level. Runs the real
+// simulation (Level::step) on every expansion, so it follows the game rules
+// exactly, and stores states compactly: the purple bit plane, entity flags
+// and movable positions. Revisited states are merged through a sharded
+// transposition table, keyed on the map's incrementally updated hash.
+//
+// Nodes are expanded one f (moves + lower bound) layer at a time, across any
+// number of threads. Each thread has its own copy of the level, and threads
+// that run out of work steal from the others' queues.
+//
+// Tiles only ever flip to purple in the shipped levels, which allows pruning
+// states where a gray tile can no longer be reached or left, and a lower
+// bound of one move per gray tile that can't be flipped 'for free' (by a
+// boost run, merge or portal vanishing).
+class Solver {
+    private:
+        std::string tiledMapPath;
+        std::vector<std::unique_ptr<SolverWorker>> workers;
+
+        int width = 0, height = 0;
+        int planeWords = 0;
+
+        // compact state layout: purple words, 2 flag bits per entity, cell
+        // index of each movable, the player's last portal, portalsRemoved.
+        // Cell indices/links take as many bytes as the map's size/entity
+        // count need
+        int stateSize = 0;
+        int flagsOffset = 0;
+        int positionsOffset = 0;
+        int linkOffset = 0;
+        int portalsOffset = 0;
+        int cellBytes = 0;
+        int linkBytes = 0;
+
+        std::vector<int> movableIDs;
+        std::vector<int> portalIDs;
+        std::vector<int> receptorIDs;
+
+        // if tiles only flip to purple, enabling pruning/the heuristic
+        bool monotone = false;
+
+        // tiles that may flip without a move of their own
+        std::vector<uint64_t> freeTiles;
+
+        StateTable table;
+
+        // nodes waiting for each f layer
+        std::vector<std::vector<SolverWork>> layers;
+
+        // nodes queued or being expanded in the current layer
+        std::atomic<long long> pending;
+
+        // goal node once found, and if the search should stop
+        std::atomic<uint32_t> goalNode;
+        std::atomic<bool> stopping;
+        std::atomic<bool> capped;
+        std::atomic<bool> cancelled;
+
+        // set by another thread to stop the current search
+        const std::atomic<bool> * cancel = nullptr;
+
+        size_t memoryCap;
+
+        inline const static SimInput MOVE_INPUTS[4] = {
+            INPUT_UP, INPUT_DOWN, INPUT_LEFT, INPUT_RIGHT
+        };
+
+        void initLayout();
+        void initFreeTiles();
+
+        // convert the worker's level state to/from compact form
+        void encode(const SolverWorker & worker, uint8_t * state) const;
+        void decode(SolverWorker & worker, const uint8_t * state) const;
+
+        // lower bound on the moves left in the worker's level state
+        int heuristic(const SolverWorker & worker) const;
+
+        // if the worker's level state can no longer be completed
+        bool isDeadState(SolverWorker & worker) const;
+
+        // if removing a cell splits the tiles left to cover in a way no
+        // movable can finish (uses the cell flags from isDeadState)
+        bool isSplit(SolverWorker & worker) const;
+
+        // expand nodes of the layer until none are left (on each thread)
+        void searchLayer(int workerIdx, int f);
+        bool popWork(int workerIdx, SolverWork & work);
+        void expand(SolverWorker & worker, SolverWork work, int f);
+
+    public:
+        inline const static uint32_t NO_NODE = StateTable::NO_NODE;
+
+        inline const static size_t DEFAULT_MEMORY_CAP = size_t(512) << 20;
+
+        Solver(std::string tiledMapPath, size_t memoryCap = DEFAULT_MEMORY_CAP);
+
+        // search from the level's initial state on the given number of threads
+        SolverResult solve(int threads = 1);
+
+        // search from the given state of the level (eg. the player's current
+        // state, for hints), stopping early once cancel is set
+        SolverResult solve(const MapState & start, int threads = 1,
+            const std::atomic<bool> * cancel = nullptr);
+
+        // if the level has a player to solve for (placeholder maps don't)
+        bool hasPlayer() const;
+
+        // if the solver's pruning/heuristic are active for this level
+        bool isMonotone() const;
+};
+
+#endif // SOLVER_HPP
@@ -0,0 +1,80 @@
+// Sharded transposition table of the solver's compact states
+
+#ifndef STATETABLE_HPP
+#define STATETABLE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+// a state in the search tree, its compact state is stored separately
+struct SolverNode {
+    uint32_t parent;
+    uint16_t g;             // moves from the start
+    uint8_t input;          // input from the parent
+    bool closed;
+    bool goal;
+};
+
+enum InsertResult {
+    INSERT_NONE,            // already stored, reached in as few moves
+    INSERT_NEW,
+    INSERT_IMPROVED,        // already stored, now reached in fewer moves
+    INSERT_FULL             // storing it would exceed the memory cap
+};
+
+// Stores nodes and their compact states, split into shards by hash so that
+// threads only contend when they touch the same shard. Each shard is an open
+// addressing table (of node index + 1, 0 ~ empty) over its own node storage.
+// Node IDs pack the shard into the low bits.
+class StateTable {
+    private:
+        struct Shard {
+            std::mutex mutex;
+            std::vector<uint8_t> states;
+            std::vector<SolverNode> nodes;
+            std::vector<uint64_t> hashes;
+            std::vector<uint32_t> table;
+        };
+
+        inline const static int SHARD_BITS = 6;
+        inline const static int SHARDS = 1 << SHARD_BITS;
+
+        std::vector<Shard> shards;
+        int stateSize = 0;
+        size_t memoryCap = 0;
+
+        std::atomic<size_t> memoryUsed;
+        std::atomic<uint32_t> nodeCount;
+
+        // bytes the shard grows by when storing another node
+        size_t growth(const Shard & shard) const;
+        void growTable(Shard & shard);
+
+    public:
+        inline const static uint32_t NO_NODE = 0xFFFFFFFF;
+
+        StateTable();
+
+        // empty the table for states of the given size
+        void reset(int stateSize, size_t memoryCap);
+
+        // store a node for the state if it's new or reached in fewer moves,
+        // with the node's ID in nodeID (unless full)
+        InsertResult insert(const uint8_t * state, uint64_t hash,
+            SolverNode node, uint32_t & nodeID);
+
+        // claim the node for expansion, false if it was already expanded or
+        // since reached in fewer moves than g
+        bool close(uint32_t nodeID, uint16_t g);
+
+        void getState(uint32_t nodeID, uint8_t * state);
+        SolverNode getNode(uint32_t nodeID);
+
+        uint32_t size() const;
+        size_t memoryUsage() const;
+};
+
+#endif // STATETABLE_HPP
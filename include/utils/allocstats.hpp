@@ -0,0 +1,27 @@
+// Counts of the heap allocations made
+
+#ifndef ALLOCSTATS_HPP
+#define ALLOCSTATS_HPP
+
+#include <atomic>
+
+// Every allocation made through operator new (and so every container/string/
+// shared_ptr) is counted, as the global operator new is replaced in
+// allocstats.cpp. Compare counts before and after some work to see how many
+// allocations it made.
+class AllocStats {
+    private:
+        inline static std::atomic<long long> allocations{0};
+
+    public:
+        static void countAllocation() {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // allocations made since the program started
+        static long long getAllocations() {
+            return allocations.load(std::memory_order_relaxed);
+        }
+};
+
+#endif // ALLOCSTATS_HPP
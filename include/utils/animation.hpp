@@ -11,9 +11,16 @@ class Animation {
             int frameWidth, int frameHeight, int msPerFrame = 40,
             bool looping = false);
 
+        // load without creating the texture, see SpriteSheet::uploadTexture
+        Animation(std::string animationPath, int frameWidth, int frameHeight,
+            int msPerFrame = 40, bool looping = false);
+        void uploadTexture(SDL_Renderer * renderer);
+
         void render(int x, int y, int frameNum, SDL_Renderer * renderer,
             double angle = 0.0) const;
 
+        std::shared_ptr<Texture> getSpritesheetTexture() const;
+
         int getMsPerFrame() const;
         int getNumFrames() const;
         int getFrameHeight() const;
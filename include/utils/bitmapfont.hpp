@@ -17,6 +17,12 @@ struct CharSpacing {
     int charXAdvance;    // how much to advance after drawing a char
 };
 
+// a character laid out to render (see BitmapFont::layoutText)
+struct Glyph {
+    SDL_Rect clip;
+    int x, y;
+};
+
 // class for a font bitmap spritesheet
 class BitmapFont {
     private:
@@ -62,12 +68,17 @@ class BitmapFont {
 
         void updateAlpha();
 
-        // build the font
-        void buildFont(std::string configPath, SDL_Renderer* renderer);
+        // build the font (without creating its texture)
+        void buildFont(std::string configPath);
 
     public:
         BitmapFont(std::string configPath, SDL_Renderer * renderer);
 
+        // load without creating the texture (eg. on a loader thread), call
+        // uploadTexture on the render thread before using it
+        BitmapFont(std::string configPath);
+        void uploadTexture(SDL_Renderer * renderer, bool keepSurface = false);
+
         // render text using the bitmap
         void initRenderDynamicText(int x, int y, const std::string & text, 
             bool typed, bool flashing = false);
@@ -79,12 +90,19 @@ class BitmapFont {
         void renderText(SDL_Renderer * renderer, const std::string & text, 
             int x, int y, unsigned int lastCharIdx) const;
 
+        // lay out text as renderText would, appending its glyphs, so text
+        // that rarely changes can be rendered without looking up each char
+        void layoutText(const char * text, int x, int y, std::vector<Glyph> & glyphs) const;
+        void renderGlyphs(SDL_Renderer * renderer, const std::vector<Glyph> & glyphs) const;
+
 
         void updateText(float delta);
         void setFontColor(const SDL_Color & fontColor);
         void setAlpha(Uint8 a);
         void setRenderingDynamic(bool renderingDynamic);
 
+        Texture * getBitmapTexture();
+
         bool isRenderingDynamic() const;
         int getLineHeight() const;
         int getTextHeight(const std::string & text) const;
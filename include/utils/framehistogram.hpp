@@ -0,0 +1,45 @@
+// class for a histogram of frame times, for percentiles
+
+#ifndef FRAMEHISTOGRAM_HPP
+#define FRAMEHISTOGRAM_HPP
+
+#include <cstdint>
+#include <string>
+
+// Counts frame times (in us) into log-linear buckets, like an HDR histogram:
+// each power of 2 is split into SUB_BUCKETS buckets, so any time is counted
+// to within ~3% in a fixed amount of memory, and recording is a couple of
+// shifts. Percentiles are read from the bucket counts.
+class FrameHistogram {
+    private:
+        const static int SUB_BITS = 5;
+        const static int SUB_BUCKETS = 1 << SUB_BITS;
+
+        // times up to 2^MAX_BITS us (~35 minutes) are counted
+        const static int MAX_BITS = 31;
+        const static int NUM_BUCKETS = SUB_BUCKETS + (MAX_BITS - SUB_BITS) * SUB_BUCKETS;
+
+        uint64_t counts[NUM_BUCKETS] = {};
+        uint64_t totalCount = 0;
+        uint64_t maxValue = 0;
+
+        static int bucketIndex(uint64_t value);
+
+        // largest value counted in the bucket
+        static uint64_t bucketValue(int index);
+
+    public:
+        void record(uint64_t us);
+
+        // smallest time (us) at least the given fraction of frames took no
+        // longer than (0 if empty)
+        uint64_t percentile(double fraction) const;
+
+        uint64_t getMax() const;
+        uint64_t getCount() const;
+
+        // write a summary, then each non-empty bucket as "<us> <count>"
+        bool save(const std::string & path) const;
+};
+
+#endif // FRAMEHISTOGRAM_HPP
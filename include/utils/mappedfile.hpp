@@ -0,0 +1,35 @@
+// Read-only memory mapped file
+
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <string>
+
+class MappedFile {
+    private:
+        const unsigned char * data = nullptr;
+        size_t size = 0;
+
+    #ifdef _WIN32
+        void * fileHandle = nullptr;
+        void * mappingHandle = nullptr;
+    #endif
+
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        MappedFile(const MappedFile &) = delete;
+        MappedFile & operator=(const MappedFile &) = delete;
+
+        // map the whole file into memory, returns false if it couldn't be
+        // opened/mapped (or is empty)
+        bool open(const std::string & path);
+        void close();
+
+        const unsigned char * getData() const;
+        size_t getSize() const;
+};
+
+#endif // MAPPEDFILE_HPP
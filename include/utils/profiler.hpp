@@ -0,0 +1,72 @@
+// Scoped timing zones, for seeing where a frame's time goes
+//
+// PROFILE_ZONE("name") times the rest of the enclosing scope. Zones are only
+// compiled in when building with PROFILING defined (make profile), otherwise
+// they compile to nothing. Samples are written to a fixed size ring buffer
+// without locks (from any thread), and Profiler::dump writes the last
+// seconds of them as Chrome trace events (open in chrome://tracing or
+// ui.perfetto.dev).
+
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#ifdef PROFILING
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name)
+#endif
+
+struct ProfileSample {
+    // index of the write + 1, stored once the rest is written (0 while being
+    // written), so a sample overwritten while being read can be told apart
+    std::atomic<uint64_t> sequence{0};
+
+    const char * name;
+    int64_t start;              // ns (steady clock)
+    int64_t duration;
+    uint32_t thread;
+};
+
+class Profiler {
+    private:
+        // ~a minute of samples at 60 fps
+        const static int CAPACITY = 1 << 16;
+
+        static ProfileSample samples[CAPACITY];
+        inline static std::atomic<uint64_t> nextSample{0};
+        inline static std::atomic<uint32_t> nextThread{0};
+
+        // small ID of the calling thread, for the trace
+        static uint32_t threadID();
+
+    public:
+        // ns (steady clock)
+        static int64_t now();
+
+        static void record(const char * name, int64_t start, int64_t end);
+
+        // write the samples from the last seconds as Chrome trace event JSON
+        static bool dump(const std::string & path, double seconds);
+};
+
+// records a sample of its lifetime (see PROFILE_ZONE)
+class ProfileZone {
+    private:
+        const char * name;
+        int64_t start;
+
+    public:
+        ProfileZone(const char * name) : name(name), start(Profiler::now()) {}
+
+        ~ProfileZone() {
+            Profiler::record(name, start, Profiler::now());
+        }
+};
+
+#endif // PROFILER_HPP
@@ -0,0 +1,56 @@
+// Counts of the draw calls made each frame
+
+#ifndef RENDERSTATS_HPP
+#define RENDERSTATS_HPP
+
+#include <SDL.h>
+
+// Textured draw calls (and switches between textures, which break up the
+// renderer's batches) are counted as they're made; endFrame stores the
+// counts of the frame just rendered.
+class RenderStats {
+    private:
+        inline static int drawCalls = 0;
+        inline static int textureSwitches = 0;
+        inline static SDL_Texture * lastTexture = nullptr;
+
+        inline static int frameDrawCalls = 0;
+        inline static int frameTextureSwitches = 0;
+
+    public:
+        static void countDraw(SDL_Texture * texture) {
+            drawCalls++;
+            if(texture != lastTexture) {
+                textureSwitches++;
+                lastTexture = texture;
+            }
+        }
+
+        static void endFrame() {
+            frameDrawCalls = drawCalls;
+            frameTextureSwitches = textureSwitches;
+
+            drawCalls = 0;
+            textureSwitches = 0;
+            lastTexture = nullptr;
+        }
+
+        // drop the counts since the last endFrame (eg. of an overlay drawn
+        // over the frame)
+        static void discardFrame() {
+            drawCalls = 0;
+            textureSwitches = 0;
+            lastTexture = nullptr;
+        }
+
+        // counts for the last frame rendered
+        static int getDrawCalls() {
+            return frameDrawCalls;
+        }
+
+        static int getTextureSwitches() {
+            return frameTextureSwitches;
+        }
+};
+
+#endif // RENDERSTATS_HPP
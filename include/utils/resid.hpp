@@ -0,0 +1,74 @@
+// Resource IDs, hashed at compile time
+
+#ifndef RESID_HPP
+#define RESID_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// A resource's ID (its key in res_paths.json) as a 64 bit FNV-1a hash. IDs
+// known at build time are hashed by the compiler (see utils/resids.hpp,
+// generated from res_paths.json, which also checks them for collisions), so
+// looking up a resource doesn't build or hash a string. IDs only known at run
+// time (eg. level IDs) are hashed from their string.
+struct ResId {
+    uint64_t hash = 0;
+
+    constexpr ResId() {}
+    constexpr ResId(const char * id) : hash(hashID(id)) {}
+    ResId(const std::string & id) : hash(hashID(id.c_str(), id.size())) {}
+
+    constexpr bool operator==(const ResId & other) const {
+        return hash == other.hash;
+    }
+
+    constexpr bool operator!=(const ResId & other) const {
+        return hash != other.hash;
+    }
+
+    static constexpr uint64_t hashID(const char * id, size_t length) {
+        uint64_t hash = FNV_OFFSET;
+        for(size_t i = 0; i < length; i++) {
+            hash = (hash ^ (unsigned char)id[i]) * FNV_PRIME;
+        }
+
+        return hash;
+    }
+
+    static constexpr uint64_t hashID(const char * id) {
+        size_t length = 0;
+        while(id[length] != '\0') length++;
+
+        return hashID(id, length);
+    }
+
+    private:
+        inline static constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+        inline static constexpr uint64_t FNV_PRIME = 1099511628211ull;
+};
+
+// true if no two of the IDs have the same hash
+template<size_t N>
+constexpr bool resIdsUnique(const ResId (& ids)[N]) {
+    for(size_t i = 0; i < N; i++) {
+        for(size_t j = i + 1; j < N; j++) {
+            if(ids[i] == ids[j]) return false;
+        }
+    }
+
+    return true;
+}
+
+// a resource of type Res resolved to its index (see ResManager::getSoundHandle),
+// so using it is an array lookup
+template<class Res>
+struct ResHandle {
+    int index = -1;
+
+    bool isValid() const {
+        return index >= 0;
+    }
+};
+
+#endif // RESID_HPP
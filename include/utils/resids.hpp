@@ -0,0 +1,144 @@
+// Resource IDs, from res/res_paths.json
+//
+// Generated by tools/genresids (make resids), don't edit by hand.
+
+#ifndef RESIDS_HPP
+#define RESIDS_HPP
+
+#include "utils/resid.hpp"
+
+// animations
+inline constexpr ResId RES_BOOST_VANISH1 = "boostVanish1";
+inline constexpr ResId RES_BOOST_VANISH2 = "boostVanish2";
+inline constexpr ResId RES_DIAMOND_MERGE = "diamondMerge";
+inline constexpr ResId RES_LOADING = "loading";
+inline constexpr ResId RES_PLAYER_MERGE = "playerMerge";
+inline constexpr ResId RES_PLAYER_MOVE_FAIL_DOWN = "playerMoveFailDown";
+inline constexpr ResId RES_PLAYER_MOVE_FAIL_LEFT = "playerMoveFailLeft";
+inline constexpr ResId RES_PLAYER_MOVE_FAIL_RIGHT = "playerMoveFailRight";
+inline constexpr ResId RES_PLAYER_MOVE_FAIL_UP = "playerMoveFailUp";
+inline constexpr ResId RES_PLAYER_TELEPORT = "playerTeleport";
+inline constexpr ResId RES_PORTAL_MERGE = "portalMerge";
+inline constexpr ResId RES_TILE_FLIP = "tileFlip";
+
+// fonts
+inline constexpr ResId RES_MAIN_FONT = "mainFont";
+
+// images
+inline constexpr ResId RES_MENU_BACK_BTN = "menu_back_btn";
+inline constexpr ResId RES_MENU_HTP_BOARD = "menu_htp_board";
+inline constexpr ResId RES_MENU_LABEL_LONG = "menu_label_long";
+inline constexpr ResId RES_MENU_LABEL_SHORT = "menu_label_short";
+inline constexpr ResId RES_MENU_LVL_BTN = "menu_lvl_btn";
+inline constexpr ResId RES_MENU_LVL_LOCKED = "menu_lvl_locked";
+inline constexpr ResId RES_MENU_MENU_BTN = "menu_menu_btn";
+inline constexpr ResId RES_MENU_TEXT_BOARD = "menu_text_board";
+inline constexpr ResId RES_PAUSE_BG = "pause_bg";
+inline constexpr ResId RES_PAUSE_LVLSELECT_BTN = "pause_lvlselect_btn";
+inline constexpr ResId RES_PLAY_MENU_BG = "play_menu_bg";
+inline constexpr ResId RES_PLAY_POSTGAME_BOARD = "play_postgame_board";
+inline constexpr ResId RES_SPLASH_BG = "splash_bg";
+inline constexpr ResId RES_WINDOW_ICON = "window_icon";
+
+// maps
+inline constexpr ResId RES_0_0 = "0-0";
+inline constexpr ResId RES_1_1 = "1-1";
+inline constexpr ResId RES_1_2 = "1-2";
+inline constexpr ResId RES_1_3 = "1-3";
+inline constexpr ResId RES_1_4 = "1-4";
+inline constexpr ResId RES_1_5 = "1-5";
+inline constexpr ResId RES_1_6 = "1-6";
+inline constexpr ResId RES_1_7 = "1-7";
+inline constexpr ResId RES_1_8 = "1-8";
+inline constexpr ResId RES_1_9 = "1-9";
+inline constexpr ResId RES_1_X = "1-X";
+inline constexpr ResId RES_2_1 = "2-1";
+inline constexpr ResId RES_2_2 = "2-2";
+inline constexpr ResId RES_2_3 = "2-3";
+inline constexpr ResId RES_2_4 = "2-4";
+inline constexpr ResId RES_2_5 = "2-5";
+inline constexpr ResId RES_2_6 = "2-6";
+inline constexpr ResId RES_2_7 = "2-7";
+inline constexpr ResId RES_2_8 = "2-8";
+inline constexpr ResId RES_2_9 = "2-9";
+inline constexpr ResId RES_2_X = "2-X";
+inline constexpr ResId RES_TESTING = "testing";
+
+// music
+inline constexpr ResId RES_MENU_MUSIC = "menuMusic";
+inline constexpr ResId RES_PLAY_MUSIC = "playMusic";
+
+// sounds
+inline constexpr ResId RES_BONK = "bonk";
+inline constexpr ResId RES_COMPLETE = "complete";
+inline constexpr ResId RES_FLIP = "flip";
+inline constexpr ResId RES_MENU_ACTIVATE = "menuActivate";
+inline constexpr ResId RES_MENU_SWITCH = "menuSwitch";
+inline constexpr ResId RES_MERGE = "merge";
+inline constexpr ResId RES_TELEPORT = "teleport";
+
+// every ID above, checked for hash collisions
+inline constexpr ResId ALL_RES_IDS[] = {
+    RES_BOOST_VANISH1,
+    RES_BOOST_VANISH2,
+    RES_DIAMOND_MERGE,
+    RES_LOADING,
+    RES_PLAYER_MERGE,
+    RES_PLAYER_MOVE_FAIL_DOWN,
+    RES_PLAYER_MOVE_FAIL_LEFT,
+    RES_PLAYER_MOVE_FAIL_RIGHT,
+    RES_PLAYER_MOVE_FAIL_UP,
+    RES_PLAYER_TELEPORT,
+    RES_PORTAL_MERGE,
+    RES_TILE_FLIP,
+    RES_MAIN_FONT,
+    RES_MENU_BACK_BTN,
+    RES_MENU_HTP_BOARD,
+    RES_MENU_LABEL_LONG,
+    RES_MENU_LABEL_SHORT,
+    RES_MENU_LVL_BTN,
+    RES_MENU_LVL_LOCKED,
+    RES_MENU_MENU_BTN,
+    RES_MENU_TEXT_BOARD,
+    RES_PAUSE_BG,
+    RES_PAUSE_LVLSELECT_BTN,
+    RES_PLAY_MENU_BG,
+    RES_PLAY_POSTGAME_BOARD,
+    RES_SPLASH_BG,
+    RES_WINDOW_ICON,
+    RES_0_0,
+    RES_1_1,
+    RES_1_2,
+    RES_1_3,
+    RES_1_4,
+    RES_1_5,
+    RES_1_6,
+    RES_1_7,
+    RES_1_8,
+    RES_1_9,
+    RES_1_X,
+    RES_2_1,
+    RES_2_2,
+    RES_2_3,
+    RES_2_4,
+    RES_2_5,
+    RES_2_6,
+    RES_2_7,
+    RES_2_8,
+    RES_2_9,
+    RES_2_X,
+    RES_TESTING,
+    RES_MENU_MUSIC,
+    RES_PLAY_MUSIC,
+    RES_BONK,
+    RES_COMPLETE,
+    RES_FLIP,
+    RES_MENU_ACTIVATE,
+    RES_MENU_SWITCH,
+    RES_MERGE,
+    RES_TELEPORT
+};
+
+static_assert(resIdsUnique(ALL_RES_IDS), "resource ID hash collision, rename one");
+
+#endif // RESIDS_HPP
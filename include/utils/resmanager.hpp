@@ -11,6 +11,9 @@
 #include <string>
 #include <functional>
 #include <fstream>
+#include <filesystem>
+#include <mutex>
+#include <thread>
 
 #include <SDL.h>
 
@@ -18,11 +21,14 @@
 #include <tmxlite/Map.hpp>
 
 #include "utils/texture.hpp"
+#include "utils/textureatlas.hpp"
 #include "utils/spritesheet.hpp"
 #include "utils/sound.hpp"
 #include "utils/music.hpp"
 #include "utils/bitmapfont.hpp"
 #include "utils/animation.hpp"
+#include "utils/resid.hpp"
+#include "utils/resids.hpp"
 
 using json = nlohmann::json;
 
@@ -31,30 +37,52 @@ class ResManager {
         SDL_Renderer * renderer;
 
         // map. holding data that maps hashes of resourceType IDs -> paths
-        std::unordered_map<int, std::string> resourcePaths;
+        std::unordered_map<uint64_t, std::string> resourcePaths;
 
         // stack of hashes of resourceIDs to be loaded
-        std::vector<int> resourcesToLoad;
+        std::vector<uint64_t> resourcesToLoad;
+
+        // Resources are decoded (images, sounds, font/tiledmap parsing) by a
+        // pool of loader threads. Each decoded resource leaves a function to
+        // store it, run on the render thread in uploadLoadedResources (the
+        // textures are uploaded, packed into atlases, once all are stored).
+        // resourcesToLoad/decodedResources are shared with the loader threads
+        // (guarded by loadMutex)
+        std::vector<std::thread> loaderThreads;
+        std::mutex loadMutex;
+        std::vector<std::function<void()>> decodedResources;
+
+        int resourcesTotal = 0;
+        int resourcesStored = 0;
+
+        // textures of the loaded resources, packed into atlases once all are
+        // loaded
+        std::vector<Texture *> atlasTextures;
+        TextureAtlas textureAtlas;
+
+        // most resources to store per call to uploadLoadedResources (per frame)
+        const int UPLOAD_BATCH_SIZE = 8;
 
         // hashmaps for game resources; 
-        //   key: hash of resource id (as specified in json file),
+        //   key: hash of resource id (as specified in json file, see ResId),
         //   val: shared ptr to resource
         
         // standalone textures
-        std::unordered_map<int, std::shared_ptr<Texture>> textures;
+        std::unordered_map<uint64_t, std::shared_ptr<Texture>> textures;
 
         // spritesheets
-        std::unordered_map<int, std::shared_ptr<SpriteSheet>> spritesheets;
+        std::unordered_map<uint64_t, std::shared_ptr<SpriteSheet>> spritesheets;
 
-        // sound fx/music
-        std::unordered_map<int, std::shared_ptr<Sound>> sounds;
-        std::unordered_map<int, std::shared_ptr<Music>> musics;
+        // sound fx (by index, see SoundHandle)/music
+        std::vector<std::shared_ptr<Sound>> sounds;
+        std::unordered_map<uint64_t, int> soundIndices;
+        std::unordered_map<uint64_t, std::shared_ptr<Music>> musics;
 
         // fonts
-        std::unordered_map<int, std::shared_ptr<BitmapFont>> fonts;
+        std::unordered_map<uint64_t, std::shared_ptr<BitmapFont>> fonts;
 
         // animations
-        std::unordered_map<int, std::shared_ptr<Animation>> animations;
+        std::unordered_map<uint64_t, std::shared_ptr<Animation>> animations;
         std::unordered_map<int, std::shared_ptr<Animation>> tileAnimations;
         std::unordered_map<int, std::shared_ptr<Animation>> playerAnimations;
         std::unordered_map<int, std::shared_ptr<Animation>> boostAnimations;
@@ -63,10 +91,10 @@ class ResManager {
         std::unordered_map<int, std::shared_ptr<Animation>> receptorAnimations;
 
         // tileset names
-        std::unordered_map<int, std::string> tilesetNames;
+        std::unordered_map<uint64_t, std::string> tilesetNames;
 
-        // for hashing
-        std::hash<std::string> resHash;
+        // add a resource's path, reporting if its ID's hash is already taken
+        void addResourcePath(const std::string & id, const std::string & path);
 
         const int ANIM_FRAMEWIDTH = 32;
         const int ANIM_FRAMEHEIGHT = 32;
@@ -84,56 +112,76 @@ class ResManager {
         inline const static std::string MUSIC_EXT = "music";
         inline const static std::string FONT_EXT = "fonts";
 
+        inline const static std::string COMPILED_MAP_EXT = ".lvl";
+        inline const static std::string TILESET_EXT = ".tsx";
+
         inline const static std::string BG_TILESET_NAME = "bgTiles";
 
-        inline const static std::string BASE_MAP_ID = "testing";
+        inline const static ResId BASE_MAP_ID = RES_TESTING;
 
         // animation ids
-        inline static const std::string TILE_FLIP_ID = "tileFlip";
-        inline const static std::string BOOST_VANISH1_ID = "boostVanish1";
-        inline const static std::string BOOST_VANISH2_ID = "boostVanish2";
-        inline const static std::string DIAMOND_MERGE_ID = "diamondMerge";
-        inline const static std::string PORTAL_MERGE_ID = "portalMerge";
-        inline const static std::string PLAYER_MERGE_ID = "playerMerge";
-        inline const static std::string PLAYER_TELEPORT_ID = "playerTeleport";
-        inline const static std::string PLAYER_MFUP_ID = "playerMoveFailUp";
-        inline const static std::string PLAYER_MFDOWN_ID = "playerMoveFailDown";
-        inline const static std::string PLAYER_MFLEFT_ID = "playerMoveFailLeft";
-        inline const static std::string PLAYER_MFRIGHT_ID = "playerMoveFailRight";
+        inline const static ResId TILE_FLIP_ID = RES_TILE_FLIP;
+        inline const static ResId BOOST_VANISH1_ID = RES_BOOST_VANISH1;
+        inline const static ResId BOOST_VANISH2_ID = RES_BOOST_VANISH2;
+        inline const static ResId DIAMOND_MERGE_ID = RES_DIAMOND_MERGE;
+        inline const static ResId PORTAL_MERGE_ID = RES_PORTAL_MERGE;
+        inline const static ResId PLAYER_MERGE_ID = RES_PLAYER_MERGE;
+        inline const static ResId PLAYER_TELEPORT_ID = RES_PLAYER_TELEPORT;
+        inline const static ResId PLAYER_MFUP_ID = RES_PLAYER_MOVE_FAIL_UP;
+        inline const static ResId PLAYER_MFDOWN_ID = RES_PLAYER_MOVE_FAIL_DOWN;
+        inline const static ResId PLAYER_MFLEFT_ID = RES_PLAYER_MOVE_FAIL_LEFT;
+        inline const static ResId PLAYER_MFRIGHT_ID = RES_PLAYER_MOVE_FAIL_RIGHT;
 
     public:
         // Construct the resource manager with a path to file containing the
         // resource paths (json)
         ResManager(std::string resourcePathsFile, SDL_Renderer * renderer);
+        ~ResManager();
+
+        ResManager(const ResManager &) = delete;
+        ResManager & operator=(const ResManager &) = delete;
 
         // parse the json file
         void parseJSON(std::string resourcePathsFile);
 
-        // load the next resource
-        void loadNextResource();
+        // start decoding the resources on the loader threads (after the audio
+        // device is opened)
+        void startLoading();
 
-        void loadTexture(int resourceIDHash, std::string resourcePath);        
-        void loadSound(int resourceIDHash, std::string resourcePath);
-        void loadMusic(int resourceIDHash, std::string resourcePath);
-        void loadSpritesheet(int resourceIDHash, std::string resourcePath);
-        void loadFont(int resourceIDHash, std::string resourcePath);
-        void loadAnimation(int resourceIDHash, std::string resourcePath);
+        // store a batch of decoded resources (on the render thread)
+        void uploadLoadedResources();
+
+        // loader thread: decode resources until there are none left
+        void loadResources();
+
+        // decode a resource, returning the function to store it
+        std::function<void()> loadResource(uint64_t resourceIDHash, std::string resourcePath);
 
         void constructAnimationMaps();
 
         bool loadingResources() const;
 
-        std::string getResExt(std::string path);
+        // fraction of resources loaded (0-1)
+        float getLoadProgress() const;
 
-        // to retrieve resources, call w/resource id
-        std::shared_ptr<Texture> getTexture(std::string id) const;
-        std::shared_ptr<SpriteSheet> getSpriteSheet(std::string id) const;
-        std::shared_ptr<Sound> getSound(std::string id) const;
-        std::shared_ptr<Music> getMusic(std::string id) const;
-        std::shared_ptr<BitmapFont> getFont(std::string id) const;
-        std::shared_ptr<Animation> getAnimation(std::string id) const;
+        bool hasFont(ResId id) const;
+
+        std::string getResExt(std::string path);
+        std::string getLevelPath(std::string tiledMapPath);
+
+        // to retrieve resources, call w/resource id (see utils/resids.hpp)
+        std::shared_ptr<Texture> getTexture(ResId id) const;
+        std::shared_ptr<SpriteSheet> getSpriteSheet(ResId id) const;
+        std::shared_ptr<Sound> getSound(ResId id) const;
+        std::shared_ptr<Music> getMusic(ResId id) const;
+        std::shared_ptr<BitmapFont> getFont(ResId id) const;
+        std::shared_ptr<Animation> getAnimation(ResId id) const;
+
+        // resolve a sound once (after loading), to play it by index
+        SoundHandle getSoundHandle(ResId id) const;
+        const std::shared_ptr<Sound> & getSound(SoundHandle sound) const;
         
-        std::string getResPath(std::string id) const;
+        const std::string & getResPath(ResId id) const;
 
         const std::unordered_map<int, std::shared_ptr<Animation>> & getTileAnimations() const;
         const std::unordered_map<int, std::shared_ptr<Animation>> & getPlayerAnimations() const;
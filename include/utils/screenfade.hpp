@@ -0,0 +1,46 @@
+// class for fading the screen out and back in (eg. between states)
+
+#ifndef SCREENFADE_HPP
+#define SCREENFADE_HPP
+
+#include <functional>
+
+#include <SDL.h>
+
+// Fades to black, runs a callback (eg. changing state, loading a level) once
+// the screen is black, then fades back in. Driven by the main loop's
+// update/render, so events, audio and loading carry on while it fades.
+class ScreenFade {
+    public:
+        ScreenFade();
+
+        // fade out, calling onFaded once black, then fade in (ignored if
+        // already fading)
+        void start(std::function<void()> onFaded);
+
+        // fade in from black
+        void fadeIn();
+
+        void update(float delta);
+        void render(SDL_Renderer * renderer, int width, int height) const;
+
+        bool isFading() const;
+
+    private:
+        enum FadePhase {FADE_NONE, FADE_OUT, FADE_IN};
+        FadePhase phase = FADE_NONE;
+
+        float opacity = 0.f;
+
+        std::function<void()> onFaded;
+
+        // ms to fade out/in (~17 frames at 60fps each way)
+        inline const static float FADE_MS = 280.f;
+        const static int OPACITY_MAX = 255;
+
+        // longest step taken in one update, so a long frame (eg. loading a
+        // level when black) doesn't skip the fade in
+        inline const static float MAX_STEP_MS = 34.f;
+};
+
+#endif // SCREENFADE_HPP
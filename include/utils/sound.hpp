@@ -8,6 +8,8 @@
 
 #include <SDL_mixer.h>
 
+#include "utils/resid.hpp"
+
 class Sound {
     private:
         std::unique_ptr<Mix_Chunk, decltype(&Mix_FreeChunk)> sound;
@@ -18,4 +20,8 @@ class Sound {
         void play();
 };
 
+// a sound resolved once, for playing without looking it up (see
+// ResManager::getSoundHandle)
+using SoundHandle = ResHandle<Sound>;
+
 #endif //SOUND_HPP
\ No newline at end of file
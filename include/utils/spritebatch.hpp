@@ -0,0 +1,59 @@
+// Batches textured draws into one SDL_RenderGeometry call per texture run
+
+#ifndef SPRITEBATCH_HPP
+#define SPRITEBATCH_HPP
+
+#include <vector>
+
+#include <SDL.h>
+
+// While a batch is open (between begin and end), Texture::render adds a quad
+// to the batch instead of drawing it. Consecutive quads sharing an SDL
+// texture/blend mode are submitted together once the texture changes, or on
+// flush/end, so draw order is kept. Anything drawn straight to the renderer
+// (rects, clears) while a batch is open must flush it first.
+//
+// Requires SDL 2.0.18 (SDL_RenderGeometry), textures render one at a time
+// with older versions.
+class SpriteBatch {
+    private:
+        inline static SDL_Renderer * renderer = nullptr;
+
+        // texture/blend mode of the pending quads
+        inline static SDL_Texture * texture = nullptr;
+        inline static SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+        inline static float texelWidth = 0.f, texelHeight = 0.f;
+
+        // pending quads (4 vertices, 6 indices each), reused between batches
+        inline static std::vector<SDL_Vertex> vertices;
+        inline static std::vector<int> indices;
+
+        inline static bool enabled = true;
+
+        inline const static double PI = 3.14159265358979323846;
+
+    public:
+        // open a batch on the given renderer
+        static void begin(SDL_Renderer * renderer);
+
+        // submit the pending quads/submit them and close the batch
+        static void flush();
+        static void end();
+
+        // if draws on the given renderer are being batched
+        static bool isBatching(SDL_Renderer * renderer) {
+            return renderer == SpriteBatch::renderer && renderer != nullptr;
+        }
+
+        // add a clip of an SDL texture, as SDL_RenderCopyEx would draw it,
+        // modulated by the given color
+        static void add(SDL_Texture * texture, SDL_BlendMode blendMode,
+            const SDL_Rect & source, const SDL_Rect & renderArea, SDL_Color color,
+            double angle = 0.0, const SDL_Point * center = NULL,
+            SDL_RendererFlip flip = SDL_FLIP_NONE);
+
+        // if batching is enabled (disabled to compare against unbatched draws)
+        static void setEnabled(bool enabled);
+};
+
+#endif // SPRITEBATCH_HPP
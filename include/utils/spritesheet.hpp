@@ -5,7 +5,6 @@
 
 #include <map>
 #include <string>
-#include <any>
 #include <functional>
 
 #include <SDL.h>
@@ -14,6 +13,7 @@
 
 #include "utils/texture.hpp"
 #include "utils/sprite.hpp"
+#include "utils/tileproperties.hpp"
 
 class SpriteSheet {
     private:
@@ -27,33 +27,37 @@ class SpriteSheet {
         std::map<int, std::shared_ptr<Sprite>> sprites;
 
         // (non-empty) tile properties, as stored in the tiledmap data
-        // key: tile ID, value: map of properties (prop. names -> values)
-        std::map<int, std::map<std::string, std::any>> tileProperties;
-
-        void loadTileProperties(const tmx::Tileset::Tile & tile);
+        TileProperties tileProperties;
 
     public:
         SpriteSheet(std::string texturePath, SDL_Renderer * renderer,
             int spriteWidth, int spriteHeight);
         SpriteSheet(std::string mapPath, std::string tilesetName, SDL_Renderer * renderer);
 
+        // load without creating the texture (eg. on a loader thread), call
+        // uploadTexture on the render thread before using it
+        SpriteSheet(std::string texturePath, int spriteWidth, int spriteHeight);
+        SpriteSheet(std::string mapPath, std::string tilesetName);
+
         // functions to load a spritesheet, either directly from a file, or
-        // via tiledmap interface + tmx loading
-        void loadSpritesheet(std::string texturePath, SDL_Renderer * renderer,
-            int spriteWidth, int spriteHeight);
-        void loadSpritesheet(std::string mapPath, std::string tilesetName, 
-            SDL_Renderer * renderer);
+        // via tiledmap interface + tmx loading (without creating the texture)
+        void loadSpritesheet(std::string texturePath, int spriteWidth, int spriteHeight);
+        void loadSpritesheet(std::string mapPath, std::string tilesetName);
+
+        // create the spritesheet texture from the loaded image
+        void uploadTexture(SDL_Renderer * renderer);
 
         // get a specified property value for a given tile
         template <class T>
         T getPropertyValue(int tileID, std::string propertyName) const {
-            return std::any_cast<T>(tileProperties.at(tileID).at(propertyName));
+            return tileProperties.getPropertyValue<T>(tileID, propertyName);
         }
 
         // Get the sprite in this sheet with the specified id
         std::shared_ptr<Sprite> getSprite(int tileID) const;
 
         SDL_Texture * getTexture() const;
+        std::shared_ptr<Texture> getSpritesheetTexture() const;
 
         int getFirstGID() const;
         int getNumSprites() const;
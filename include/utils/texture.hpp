@@ -34,6 +34,22 @@ class Texture {
         // for pixel access (e.g. for bitmap textures)
         void * texturePixels;
 
+        // decoded image waiting to be uploaded (see loadSurface)
+        std::shared_ptr<SDL_Surface> surface;
+        bool bitmap = false;
+
+        // area of the SDL texture holding this texture's image (all of it,
+        // unless it's packed in an atlas with others)
+        SDL_Rect region = {0, 0, 0, 0};
+        bool atlased = false;
+
+        // color/alpha modulation and blending, applied on each render when
+        // the SDL texture is shared by an atlas
+        SDL_Color colorMod = {0xFF, 0xFF, 0xFF, 0xFF};
+        SDL_BlendMode blendMode = SDL_BLENDMODE_BLEND;
+
+        void applyModulation() const;
+
     public:
         Texture();
 
@@ -43,6 +59,18 @@ class Texture {
         // load a bitmap texture
         void loadBitmapTexture(std::string path, SDL_Renderer * renderer);
 
+        // decode an image without creating the texture (doesn't touch the
+        // renderer, so it can run on any thread), then create it from the
+        // decoded image on the render thread
+        bool loadSurface(std::string path, bool bitmap = false);
+        void uploadSurface(SDL_Renderer * renderer, bool keepSurface = false);
+
+        // the decoded image (null once uploaded), eg. for packing an atlas
+        SDL_Surface * getSurface() const;
+
+        // use a region of a (shared) atlas texture as this texture
+        void setAtlasRegion(std::shared_ptr<SDL_Texture> atlas, const SDL_Rect & region);
+
         // set texture color
         void setColor(Uint8 red, Uint8 green, Uint8 blue);
 
@@ -69,6 +97,11 @@ class Texture {
             double angle = 0.0, SDL_Point* center = NULL,
             SDL_RendererFlip flip = SDL_FLIP_NONE) const;
 
+        // render a clip of the texture (all of it if null) to the given area
+        void render(SDL_Renderer * renderer, const SDL_Rect * clip, const SDL_Rect & renderArea,
+            double angle = 0.0, SDL_Point * center = NULL,
+            SDL_RendererFlip flip = SDL_FLIP_NONE) const;
+
         int getHeight();
         int getWidth();
         std::shared_ptr<SDL_Texture> getTexture() const;
@@ -0,0 +1,47 @@
+// Packs textures' images into shared atlas textures
+
+#ifndef TEXTUREATLAS_HPP
+#define TEXTUREATLAS_HPP
+
+#include <memory>
+#include <vector>
+
+#include <SDL.h>
+
+#include "utils/texture.hpp"
+
+// Textures drawn together (sprites, animation frames, font glyphs, GUI
+// images) are packed into a few large SDL textures, so a frame switches
+// textures (and breaks the renderer's batches) less often. Each texture keeps
+// its own region/modulation (see Texture::setAtlasRegion), so they render as
+// before.
+class TextureAtlas {
+    private:
+        std::vector<std::shared_ptr<SDL_Texture>> atlases;
+
+        // atlas size (or the renderer's max texture size, if smaller)
+        const int ATLAS_SIZE = 2048;
+
+        // images larger than this (eg. backgrounds) aren't worth packing
+        const int MAX_PACKED_SIZE = 512;
+
+        // gap between images, so clips don't bleed into their neighbours
+        const int PADDING = 1;
+
+        // if packing is enabled (disabled to compare against unpacked textures)
+        inline static bool enabled = true;
+
+    public:
+        TextureAtlas();
+
+        // pack the decoded images of the given textures into atlases and
+        // upload them (on the render thread). Textures that aren't packed are
+        // uploaded on their own
+        void build(const std::vector<Texture *> & textures, SDL_Renderer * renderer);
+
+        int getAtlasCount() const;
+
+        static void setEnabled(bool enabled);
+};
+
+#endif // TEXTUREATLAS_HPP
@@ -0,0 +1,35 @@
+// Wrapper for the custom tile properties of a tiledmap tileset
+
+#ifndef TILEPROPERTIES_HPP
+#define TILEPROPERTIES_HPP
+
+#include <map>
+#include <string>
+#include <any>
+
+#include <tmxlite/Tileset.hpp>
+
+class TileProperties {
+    private:
+        // (non-empty) tile properties, as stored in the tiledmap data
+        // key: tile ID, value: map of properties (prop. names -> values)
+        std::map<int, std::map<std::string, std::any>> tileProperties;
+
+    public:
+        TileProperties();
+        TileProperties(const tmx::Tileset & tileset);
+
+        // load the properties of each tile in the tileset
+        void loadTileProperties(const tmx::Tileset & tileset);
+        void loadTileProperties(const tmx::Tileset::Tile & tile);
+
+        // get a specified property value for a given tile
+        template <class T>
+        T getPropertyValue(int tileID, std::string propertyName) const {
+            return std::any_cast<T>(tileProperties.at(tileID).at(propertyName));
+        }
+
+        bool hasProperty(int tileID, std::string propertyName) const;
+};
+
+#endif // TILEPROPERTIES_HPP
@@ -0,0 +1,80 @@
+// Presentation of a single entity/tile of a level: sprite, animations and
+// smooth movement between grid positions
+
+#ifndef ENTITYVIEW_HPP
+#define ENTITYVIEW_HPP
+
+#include <SDL.h>
+
+#include <memory>
+#include <utility>
+#include <unordered_map>
+
+#include "utils/sprite.hpp"
+#include "utils/animator.hpp"
+
+class EntityView {
+    protected:
+        // Texture for the entity
+        std::shared_ptr<Sprite> entitySprite;
+
+        // render area on the screen
+        SDL_Rect renderArea;
+
+        // position before the last update, rendering interpolates from it
+        int prevX, prevY;
+
+        // rotation angle
+        double angle = 0.0;
+
+        // animator for this entity
+        Animator entityAnimator;
+
+        // hold all animations to be used by this entity, key = enum ID val.
+        const std::unordered_map<int, std::shared_ptr<Animation>> * entityAnimations;
+
+        // if the entity is no longer shown (outside of animations)
+        bool hidden = false;
+
+        // Movement progress + tracking
+        float moveProg = 1.f;
+        int startX, startY, endX, endY;   // Start and end positions for movement
+
+        int velocity;                     // Tiles moved per sec.
+
+    public:
+        EntityView(int screenX, int screenY, std::shared_ptr<Sprite> entitySprite,
+            const std::unordered_map<int, std::shared_ptr<Animation>> & entityAnimations,
+            int velocity = 0);
+
+        void update(float delta);
+        // render alpha of the way from the previous update's position to the
+        // current one
+        void render(SDL_Renderer * renderer, float alpha = 1.f) const;
+
+        static std::pair<int,int> lerp(int startX, int startY, int endX,
+            int endY, float t);
+
+        // start moving to the specified screen position
+        void moveTo(int x, int y);
+        void setPosition(int x, int y);
+
+        void activateAnimation(int animationID, bool reverse = false);
+        void stopAnimator();
+
+        void setSprite(std::shared_ptr<Sprite> sprite);
+        void setAngle(double angle);
+        void setHidden(bool hidden);
+
+        int getScreenX() const;
+        int getScreenY() const;
+        int getWidth() const;
+        int getHeight() const;
+        float getMoveProg() const;
+
+        bool isMoving() const;
+        bool isAnimating() const;
+        bool isHidden() const;
+};
+
+#endif // ENTITYVIEW_HPP
@@ -0,0 +1,149 @@
+// Presentation of a level: renders the simulation state, plays back the
+// events of each simulation step as animations/sounds, and maps keyboard
+// input to simulation inputs
+
+#ifndef LEVELVIEW_HPP
+#define LEVELVIEW_HPP
+
+#include <SDL.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include "level/level.hpp"
+#include "level/simevent.hpp"
+#include "utils/resids.hpp"
+#include "utils/sound.hpp"
+#include "view/entityview.hpp"
+#include "view/tile.hpp"
+
+class MemSwap;
+
+class LevelView {
+    private:
+        MemSwap * mGame = nullptr;
+
+        int renderX = 0, renderY = 0;          // x,y on the screen to render map
+        int tileWidth = 0, tileHeight = 0;     // size of tiles in pixels
+        int mapWidth = 0;                      // width of map in tiles
+        int mapHeight = 0;                     // height of map in tiles
+
+        // A vector holding the background tiles for the map
+        std::vector<Tile> mapTiles;
+
+        // tiles playing their flip animation (drawn over the cached background)
+        std::vector<int> animatingTiles;
+
+        // The background tiles are drawn once into a render target, then
+        // only tiles that changed (dirty) are redrawn into it. Animating
+        // tiles are left out of it, and drawn on top each frame. Updated in
+        // render, hence mutable
+        mutable std::shared_ptr<SDL_Texture> backgroundTexture;
+        mutable bool backgroundValid = false;
+        mutable std::vector<int> dirtyTiles;
+
+        // MemSwap's count of render target resets when the cache was drawn
+        mutable int renderResets = 0;
+
+        // store tile sprites for parity tiles (key: parity, val: sprite ptr)
+        std::unordered_map<int, std::shared_ptr<Sprite>> parityTileSprites;
+
+        // views of the level's entities, indexed by entity ID
+        std::vector<EntityView> entityViews;
+
+        // animation played when each entity vanishes/merges
+        std::vector<int> vanishAnimations;
+
+        // order to render entity views in (movables drawn on top)
+        std::vector<int> renderOrder;
+
+        int playerID = -1;
+
+        // events of the last simulation step still to be played back
+        std::vector<SimEvent> pendingEvents;
+        unsigned int currEvent = 0;
+
+        // the entity view whose movement/animation playback is waiting on
+        int blockingView = -1;
+
+        // teleport destination while the teleport-in animation plays
+        bool teleporting = false;
+        int teleportX = 0, teleportY = 0;
+
+        // boosts being ridden, which vanish once their rider moves off
+        std::vector<int> activeBoosts;
+
+        // tile the hinted move leads to, outlined while shown
+        bool showingHint = false;
+        SDL_Rect hintRect = {0, 0, 0, 0};
+        inline const static int HINT_OUTLINE = 2;
+
+        // buffered movement input
+        SimInput bufferedInput = INPUT_NONE;
+        const float MOVEMENT_BUFFER = 0.85f;
+
+        // track when a player is undoing a buffer/set to BUFFER_CAP each time
+        static const int UNDO_BUFFER_CAP = 10;
+        int undoBuffer = 0;
+
+        static const int PLAYER_VELOCITY = 6;
+        static const int DIAMOND_VELOCITY = 3;
+
+        enum PlayerAnimation {PLAYER_MERGE, PLAYER_MOVEFAIL_UP, PLAYER_MOVEFAIL_DOWN,
+            PLAYER_MOVEFAIL_LEFT, PLAYER_MOVEFAIL_RIGHT, PLAYER_TELEPORT};
+        enum BoostAnimation {BOOST_VANISH1, BOOST_VANISH2};
+        enum DiamondAnimation {DIAMOND_MERGE};
+        enum PortalAnimation {PORTAL_MERGE};
+
+        inline const static ResId FLIP_SOUND_ID = RES_FLIP;
+        inline const static ResId BONK_SOUND_ID = RES_BONK;
+        inline const static ResId MERGE_SOUND_ID = RES_MERGE;
+        inline const static ResId TELEPORT_SOUND_ID = RES_TELEPORT;
+
+        // the sounds played by events, resolved on build
+        SoundHandle flipSound, bonkSound, mergeSound, teleportSound;
+
+        // step the simulation, queueing its events for playback
+        void stepLevel(Level & level, SimInput input);
+
+        void playEvent(const SimEvent & event);
+        bool waitingOnView();
+        void vanishBoosts(int gridX, int gridY);
+
+        int toScreenX(int gridX) const;
+        int toScreenY(int gridY) const;
+
+        // start a tile's flip animation, taking it out of the cached background
+        void flipTile(int index, std::shared_ptr<Sprite> sprite);
+
+        // bring the cached background up to date and draw it, returns false
+        // if render targets aren't supported
+        bool renderBackground(SDL_Renderer * renderer) const;
+
+    public:
+        LevelView();
+
+        // create views for the level's current tiles/entities
+        void build(const Level & level, MemSwap * game);
+
+        // snap views to the level's current state (eg. after an undo)
+        void sync(const Level & level);
+
+        void handleEvents(Level & level, const Uint8 * keyStates);
+        void update(float delta);
+        void render(SDL_Renderer * renderer) const;
+
+        // if events are still being played back
+        bool isAnimating() const;
+
+        // if nothing is moving/animating, or waiting on input timing
+        bool isIdle() const;
+
+        // outline where the given move takes the player/stop outlining it
+        void showHint(const Level & level, SimInput move);
+        void clearHint();
+};
+
+#endif // LEVELVIEW_HPP
@@ -0,0 +1,31 @@
+#ifndef TILE_HPP
+#define TILE_HPP
+
+#include <SDL.h>
+
+#include "utils/sprite.hpp"
+
+#include "view/entityview.hpp"
+
+class Tile : public EntityView {
+    private:
+        bool flipped = false;
+
+        // tile animations
+        enum TileAnimation {TILE_FLIP};
+
+    public:
+        Tile(int screenX, int screenY, std::shared_ptr<Sprite> sprite,
+            const std::unordered_map<int, std::shared_ptr<Animation>> & entityAnimations);
+
+        // flip the tile parity sprite
+        void flip(std::shared_ptr<Sprite> newTileSprite, bool undo);
+
+        // render the tile's sprite at x,y, ignoring animations (eg. into the
+        // cached background)
+        void renderSprite(SDL_Renderer * renderer, int x, int y) const;
+
+        bool isFlipped() const;
+};
+
+#endif
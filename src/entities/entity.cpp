@@ -4,23 +4,12 @@
 #include "level/map.hpp"
 #include "level/level.hpp"
 
-Entity::Entity(int screenX, int screenY, int gridX, int gridY, int parity, 
-    std::shared_ptr<Sprite> entitySprite,
-    const std::unordered_map<int, std::shared_ptr<Animation>> & entityAnimations) : 
-    gridX(gridX), gridY(gridY), parity((Parity)parity), entitySprite(entitySprite),
-    renderArea{screenX, screenY, entitySprite->getWidth(), entitySprite->getHeight()}, 
-    entityAnimations(entityAnimations) {}
-
-Entity::Entity(int screenX, int screenY, int parity, 
-    std::shared_ptr<Sprite> entitySprite,
-    const std::unordered_map<int, std::shared_ptr<Animation>> & entityAnimations) : 
-    gridX(0), gridY(0), parity(Parity(parity)), entitySprite(entitySprite), 
-    renderArea{screenX, screenY, entitySprite->getWidth(), entitySprite->getHeight()},
-    entityAnimations(entityAnimations) {}
+Entity::Entity(int gridX, int gridY, int parity, EntityKind kind) :
+    gridX(gridX), gridY(gridY), parity((Parity)parity), kind(kind) {}
 
 /**
  * @brief Checks collision for current entity with the specified destination
- * 
+ *
  * @return true if there is a collision (including with the boundary)
  */
 bool Entity::checkCollision(Level * level, int destGridX, int destGridY) {
@@ -28,29 +17,29 @@ bool Entity::checkCollision(Level * level, int destGridX, int destGridY) {
     if(!level->inBounds(destGridX, destGridY)) return true;
 
     // check collision with dest position. Return true if non-null entity
-    bool entityAtNewPos = 
+    bool entityAtNewPos =
         level->getGridElement<Entity>(destGridX, destGridY) != nullptr;
 
     return entityAtNewPos;
 }
 
-void Entity::update(Level * level, float delta) {
-    // update animation if needed
-    if(entityAnimator.isAnimating()) {
-        entityAnimator.update(delta);
-    }
+void Entity::saveState(EntityState & state) const {
+    state.gridX = gridX;
+    state.gridY = gridY;
+    state.vanished = vanished;
+    state.link = -1;
 }
 
-void Entity::render(SDL_Renderer * renderer) const {
-    if(entityAnimator.isAnimating()) {
-        entityAnimator.render(renderArea.x, renderArea.y, renderer, angle);
-    } else if(!vanished) {
-        entitySprite->render(renderer, renderArea);
-    }
+void Entity::loadState(const EntityState & state,
+    [[maybe_unused]] const std::vector<std::shared_ptr<Entity>> & entities) {
+
+    gridX = state.gridX;
+    gridY = state.gridY;
+    vanished = state.vanished;
 }
 
 // return the coordinates for the specified direction, relative to the entity
-std::pair<int, int> Entity::getCoords(Direction direction) {
+std::pair<int, int> Entity::getCoords(Direction direction) const {
     switch(direction) {
         case DIR_UP:
             return std::pair<int, int> (gridX, gridY - 1);
@@ -73,30 +62,6 @@ std::pair<int, int> Entity::getCoords(Direction direction) {
     }
 }
 
-void Entity::setScreenX(int x) {
-    renderArea.x = x;
-}
-
-void Entity::setScreenY(int y) {
-    renderArea.y = y;
-}
-
-int Entity::getScreenX() const {
-    return renderArea.x;
-}
-
-int Entity::getScreenY() const {
-    return renderArea.y;
-}
-
-int Entity::getWidth() const {
-    return renderArea.w;
-}
-
-int Entity::getHeight() const {
-    return renderArea.h;
-}
-
 void Entity::setGridX(int x) {
     gridX = x;
 }
@@ -105,8 +70,8 @@ void Entity::setGridY(int y) {
     gridY = y;
 }
 
-void Entity::stopAnimator() {
-    entityAnimator.setAnimating(false);
+void Entity::setEntityID(int id) {
+    entityID = id;
 }
 
 int Entity::getGridX() const {
@@ -117,13 +82,16 @@ int Entity::getGridY() const {
     return gridY;
 }
 
+int Entity::getEntityID() const {
+    return entityID;
+}
+
 Parity Entity::getParity() const {
     return parity;
 }
 
-void Entity::activateAnimation(int animationID, bool reverse) {
-    entityAnimator.setCurrAnimation(entityAnimations.at(animationID));
-    entityAnimator.start(reverse);
+EntityKind Entity::getKind() const {
+    return kind;
 }
 
 void Entity::setVanished(bool vanished) {
@@ -133,7 +101,3 @@ void Entity::setVanished(bool vanished) {
 bool Entity::isVanished() const {
     return vanished;
 }
-
-bool Entity::isAnimating() const {
-    return entityAnimator.isAnimating();
-}
\ No newline at end of file
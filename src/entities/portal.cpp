@@ -2,70 +2,10 @@
 
 #include "entities/portal.hpp"
 #include "entities/player.hpp"
+#include "level/level.hpp"
 
-Portal::Portal(int screenX, int screenY, int gridX, int gridY, int parity,
-    std::shared_ptr<Sprite> entitySprite,
-    const std::unordered_map<int, std::shared_ptr<Animation>> & entityAnimations) : 
-    Entity(screenX, screenY, gridX, gridY, parity, entitySprite, entityAnimations) {}
-
-void Portal::handleEvents(const Uint8 * keyStates, Level * level) {
-
-}
-
-void Portal::update(Level * level, float delta) {
-    // if activated, handle player updates
-    if(activated && player.get()) {
-        // if player is done moving onto the portal, proceed with the teleport
-        if(!player->isMoving() && player->isTeleporting()) {
-            // activate player teleport-in animation
-            if(!player->isVanished()) {
-                player->activateAnimation(Player::PlayerAnimation::PLAYER_TELEPORT);
-                player->setVanished(true);
-                level->playSound(TELEPORT_SOUND_ID);
-            } else if(!player->isAnimating()) {
-                // once animation finished, teleport the player + activate teleport-out animation (reversed)
-                teleportPlayer(level);
-                player->setTeleporting(false);
-                player->setVanished(false);
-
-                player->activateAnimation(Player::PlayerAnimation::PLAYER_TELEPORT, true);
-
-                // transfer ownership of player to otherPortal
-                player->setLastPortal(otherPortal);
-                otherPortal->setPlayer(player);
-                player.reset();
-                checkSurrounded(level);
-                return;
-            }
-        }
-
-        // if player has moved off of the portal, place them back in the grid
-        if((!(player->getGridX() == gridX && player->getGridY() == gridY)) &&
-            ((player->getScreenX() > getScreenX() || player->getScreenX() + player->getWidth() <= getScreenX()) ||
-            (player->getScreenY() > getScreenY() || player->getScreenY() + player->getHeight() <= getScreenY()))) {
-            
-            // give ownership back to level
-            level->placePortals();
-
-            //checkSurrounded(level, false);
-            resetPortalStatus(level);
-        }
-    }
-
-    Entity::update(level, delta);
-}
-
-void Portal::render(SDL_Renderer* renderer) const {
-    Entity::render(renderer);
-}
-
-// transfer ownership of portals back to level/reset active status
-void Portal::resetPortalStatus(Level * level) {
-    // reset portal status/player pointer
-    setActivated(false);
-    setRemoved(false);
-    player.reset();
-}
+Portal::Portal(int gridX, int gridY, int parity) :
+    Entity(gridX, gridY, parity, ENTITY_PORTAL) {}
 
 // check if a portal is surrounded by purple tiles, if so -> vanish
 void Portal::checkSurrounded(Level * level) {
@@ -77,7 +17,7 @@ void Portal::checkSurrounded(Level * level) {
     coords[2] = getCoords(DIR_LEFT);
     coords[3] = getCoords(DIR_RIGHT);
 
-    // check if each is a purple tile    
+    // check if each is a purple tile
     for(int i = 0; i < 4; i++) {
         if(level->getTileParity(coords[i].first, coords[i].second) != PARITY_PURPLE) {
 
@@ -86,80 +26,31 @@ void Portal::checkSurrounded(Level * level) {
         }
     }
 
-    // if made it here, considered 'surrounded' -> activate vanish anim.
-    activateAnimation(PORTAL_MERGE);
-    vanished = true;
+    // if made it here, considered 'surrounded' -> vanish
+    level->setVanished(this, true);
+    level->addEvent({EVENT_VANISH, entityID, -1, gridX, gridY, gridX, gridY, 0});
 
     // flip tile
     level->flipMapTiles(gridX, gridY, parity);
 }
 
-// teleport the player to the other portal, placing it back in the grid
-void Portal::teleportPlayer(Level * level, bool undo) {
+// teleport the player to the other portal
+void Portal::teleportPlayer(Level * level, Player * player) {
     level->moveGridElement(player->getGridX(), player->getGridY(),
         otherPortal->getGridX(), otherPortal->getGridY());
 
-    // update player render position
-    player->setScreenX(otherPortal->getScreenX());
-    player->setScreenY(otherPortal->getScreenY());
+    level->addEvent({EVENT_TELEPORT, player->getEntityID(), entityID, gridX, gridY,
+        otherPortal->getGridX(), otherPortal->getGridY(), 0});
 
-    // add a teleport to the player's action history if not undoing
-    if(!undo) {
-        player->pushAction(Movable::MovableAction::TELEPORT);
-    } else {
-        // otherwise, place the portals back/transfer back player ownership
-        player->setLastPortal(otherPortal);
-        otherPortal->setVanished(false);
-        otherPortal->setPlayer(player);
-        resetPortalStatus(level);
-
-        // undo potential tileflip
-        if(level->getTileParity(otherPortal->getGridX(), otherPortal->getGridY()) == PARITY_PURPLE) {
-            level->flipMapTiles(otherPortal->getGridX(), otherPortal->getGridY(), PARITY_GRAY, undo);
-        }
-    }
-}
-
-// temporarily lift portals from grid
-void Portal::removePortals(Level * level) {
-    level->removeGridElement(gridX, gridY);
-    level->removeGridElement(otherPortal->getGridX(), otherPortal->getGridY());
-
-    setRemoved(true);
-}
-
-// set player of this portal, from which they will teleport to the otherPortal (whose player is unset)
-void Portal::setPlayer(std::shared_ptr<Player> player) {
-    this->player = player;
+    // player now exits from the other portal
+    level->setLastPortal(player, otherPortal);
+    checkSurrounded(level);
 }
 
-std::shared_ptr<Player> Portal::getPlayer() const {
-    return player;
-}
-
-void Portal::setOtherPortal(std::shared_ptr<Portal> otherPortal) {
+void Portal::setOtherPortal(Portal * otherPortal) {
     this->otherPortal = otherPortal;
 }
 
-void Portal::setRemoved(bool removed) {
-    this->removed = removed;
-    if(otherPortal->isRemoved() != removed) {
-        otherPortal->setRemoved(removed);
-    } 
-}
-
-bool Portal::isRemoved() const {
-    return removed;
+Portal * Portal::getOtherPortal() const {
+    return otherPortal;
 }
-
-// maintain activated status for both portals
-void Portal::setActivated(bool activated) {
-    this->activated = activated;
-    if(otherPortal->isActivated() != activated) {
-        otherPortal->setActivated(activated);
-    }
-}
-
-bool Portal::isActivated() const {
-    return activated;
-}
\ No newline at end of file
@@ -2,31 +2,17 @@
 
 #include "entities/receptor.hpp"
 
-Receptor::Receptor(int screenX, int screenY, int gridX, int gridY, int parity,
-    std::shared_ptr<Sprite> entitySprite, std::string shape,
-    const std::unordered_map<int, std::shared_ptr<Animation>> & entityAnimations) : 
-    Entity(screenX, screenY, gridX, gridY, parity, entitySprite, entityAnimations), 
-    shape(shape) {}
-
-
-void Receptor::handleEvents(const Uint8 * keyStates, Level * level) {
-
-}
-
-void Receptor::update(Level * level, float delta) {}
-
-void Receptor::render(SDL_Renderer* renderer) const {
-    Entity::render(renderer);
-}
+Receptor::Receptor(int gridX, int gridY, int parity, std::string shape) :
+    Entity(gridX, gridY, parity, ENTITY_RECEPTOR), shape(shape) {}
 
 void Receptor::setCompleted(bool completed) {
-    this->completed = completed;
+    vanished = completed;
 }
 
 bool Receptor::isCompleted() const {
-    return completed;
+    return vanished;
 }
 
-std::string Receptor::getShape() const {
+const std::string & Receptor::getShape() const {
     return shape;
-}
\ No newline at end of file
+}
@@ -11,6 +11,7 @@
 
 #include "memswap.hpp"
 #include "gameStates/menustate.hpp"
+#include "utils/profiler.hpp"
 
 MenuState::MenuState(MemSwap * game) : GameState(GAME_STATE_MENU),
     bgTexture(game->getResManager().getTexture(BG_ID)),
@@ -30,6 +31,8 @@ MenuState::MenuState(MemSwap * game) : GameState(GAME_STATE_MENU),
 
 
 void MenuState::enterState(MemSwap * game) {
+    PROFILE_ZONE("MenuState::enterState");
+
     // get current menu screen (or if first time entering, do nothing)
     if(returning) {
         currScreen = (MenuScreen) game->getCurrMenuScreen();
@@ -252,6 +255,8 @@ void MenuState::addTextBoard(std::vector<Label> & labels, std::string label,
 }
 
 void MenuState::handleEvents(MemSwap * game, const SDL_Event & e) {
+    PROFILE_ZONE("MenuState::handleEvents");
+
     currButton->handleEvents(e);
 
     // handle switching button focus (except for credit screen [only back btn])
@@ -360,6 +365,8 @@ void MenuState::changeCurrButton(const SDL_Event & e, MemSwap * game) {
 
 // update the current button and check for activations
 void MenuState::update(MemSwap * game, float delta) {
+    PROFILE_ZONE("MenuState::update");
+
     currButton->update();
 
     // check if current button is activated
@@ -454,6 +461,8 @@ void MenuState::updateCurrButton() {
 
 /// Render function for the game state
 void MenuState::render(SDL_Renderer * renderer) const {
+    PROFILE_ZONE("MenuState::render");
+
     // scrolling background texture
     bgTexture->render((int)currScrollX, 0, renderer);
 
@@ -13,6 +13,7 @@
 #include "gameStates/menustate.hpp"
 #include "gameStates/pausestate.hpp"
 #include "utils/music.hpp"
+#include "utils/profiler.hpp"
 
 PauseState::PauseState(MemSwap * game) : GameState(GAME_STATE_PAUSE) {
     // get bg texture
@@ -58,6 +59,8 @@ void PauseState::exitState() {
 }
 
 void PauseState::handleEvents(MemSwap * game, const SDL_Event & e) {
+    PROFILE_ZONE("PauseState::handleEvents");
+
     // handle events for curr button
     buttons.at(currButton).handleEvents(e);
 
@@ -84,6 +87,15 @@ void PauseState::changeCurrButton(bool left, MemSwap * game) {
 }
 
 void PauseState::update(MemSwap * game, float delta) {
+    PROFILE_ZONE("PauseState::update");
+
+    // resume straight away when playing back a replay (it's the play state's
+    // input that's replayed)
+    if(game->getPlayback().get()) {
+        game->setNextState(GAME_STATE_PLAY);
+        return;
+    }
+
     buttons.at(currButton).update();
 
     // check if the current button has been activated
@@ -115,6 +127,8 @@ void PauseState::update(MemSwap * game, float delta) {
 
 /// Render function for the game state
 void PauseState::render(SDL_Renderer * renderer) const {
+    PROFILE_ZONE("PauseState::render");
+
     bgTexture->render(0, 0, renderer);
 
     // render each of the buttons
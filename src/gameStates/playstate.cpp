@@ -1,7 +1,10 @@
 // implementation for Play state
+#include <cstdio>
+
 #include "memswap.hpp"
 #include "gameStates/menustate.hpp"
 #include "gameStates/playstate.hpp"
+#include "utils/profiler.hpp"
 
 PlayState::PlayState(MemSwap * game) : GameState(GAME_STATE_PLAY),
     postGameBoard(game->getScreenWidth() / 2 - 
@@ -12,6 +15,9 @@ PlayState::PlayState(MemSwap * game) : GameState(GAME_STATE_PLAY),
         game->getResManager().getFont(FONT_ID), POSTGAME_TEXT,
         game->getButtonTextColor(), Label::TextAlignment::ALIGN_CENTER,
         Label::TextAlignment::ALIGN_TOP),
+    hintEngine((size_t)SDL_GetSystemRAM() << 20),
+    hintFont(game->getResManager().getFont(FONT_ID)),
+    hintColor(game->getButtonTextColor()),
     playMusic(game->getResManager().getMusic(PLAY_MUSIC_ID)) {
             
     postGameButtons = MenuState::getSpacedButtons(postGameMenuLabels,
@@ -21,9 +27,14 @@ PlayState::PlayState(MemSwap * game) : GameState(GAME_STATE_PLAY),
         postGameBoard.getScreenY() + postGameBoard.getHeight(),
         game->getOutlineColor(), game->getButtonTextColor(), 
         MenuState::MenuScreen::PLAY_POSTGAME);
+
+    recordDir = game->getRecordDir();
+    hintGlyphs.reserve(HINT_TEXT_MAX);
 }
 
 void PlayState::enterState(MemSwap * game) {
+    PROFILE_ZONE("PlayState::enterState");
+
     // load current level (if entering from non-paused state)
     if(game->isPaused()) {
         game->setPaused(false);
@@ -34,15 +45,112 @@ void PlayState::enterState(MemSwap * game) {
     }
 }
 
-// load the curr. level + fade out/in
+// load the curr. level + fade out/in (when entering the state, it's already
+// being faded in)
 void PlayState::loadLevel(MemSwap * game, bool enteringState) {
-    if(!enteringState) fade(game->getRenderer(), game, false);
+    if(enteringState) {
+        swapInLevel(game);
+        return;
+    }
+
+    // load in the background while fading out
+    levelLoader.prefetch(game->getResManager().getResPath(game->getCurrLevelID()));
+
+    game->startFade([this, game]() {
+        swapInLevel(game);
+    });
+}
+
+// swap in the current level, once it's loaded
+void PlayState::swapInLevel(MemSwap * game) {
+    PROFILE_ZONE("PlayState::swapInLevel");
+
+    // done with the level being replaced
+    finishRecording();
 
     std::string levelPath = game->getResManager().getResPath(game->getCurrLevelID());
-    level = Level(levelPath, game->getRenderer(), game);
+    clearHint();
+
+    // swap in the level if it was prefetched, else load it now
+    if(!levelLoader.take(levelPath, level)) {
+        level = Level(levelPath);
+    }
+    levelView.build(level, game);
     levelComplete = false;
 
-    if(!enteringState) fade(game->getRenderer(), game, true);
+    startReplay(game);
+}
+
+// record the level just loaded, or play it back if it's the replay's level
+void PlayState::startReplay(MemSwap * game) {
+    auto replay = game->getPlayback();
+
+    if(replay.get() && replay->getLevelID() == game->getCurrLevelID()) {
+        playback = replay;
+        playedBack = Replay(replay->getLevelID());
+        level.setRecorder(&playedBack);
+    } else if(!recordDir.empty()) {
+        recorded = Replay(game->getCurrLevelID());
+        level.setRecorder(&recorded);
+        recording = true;
+    }
+}
+
+void PlayState::finishRecording() {
+    if(!recording) return;
+
+    recording = false;
+    level.setRecorder(nullptr);
+
+    recorded.finish(level.getHash());
+    recorded.save(recordDir + "/" + recorded.getLevelID() + ".rpl");
+}
+
+// check the level ended up where it did when recorded, then exit
+void PlayState::finishPlayback(MemSwap * game) {
+    level.setRecorder(nullptr);
+
+    bool matches = level.getHash() == playback->getFinalHash();
+    int difference = playedBack.firstDifference(*playback);
+
+    printf("Replay of %s %s (%u ticks, %zu inputs)\n", playback->getLevelID().c_str(),
+        matches ? "matches" : "diverged", playback->getTickCount(),
+        playback->getSteps().size());
+
+    if(difference != -1) {
+        printf("First differing input: %d\n", difference);
+    }
+
+    playback.reset();
+    game->setNextState(GAME_STATE_EXIT);
+}
+
+// the recorded keys held in the given key states, as ReplayKey flags
+uint8_t PlayState::toReplayKeys(const Uint8 * keyStates) const {
+    uint8_t keys = 0;
+
+    for(unsigned int i = 0; i < std::size(REPLAY_SCANCODES); i++) {
+        if(keyStates[REPLAY_SCANCODES[i]]) keys |= 1 << i;
+    }
+
+    return keys;
+}
+
+// key states with the given ReplayKey flags held
+const Uint8 * PlayState::toKeyStates(uint8_t keys) {
+    for(unsigned int i = 0; i < std::size(REPLAY_SCANCODES); i++) {
+        tickKeyStates[REPLAY_SCANCODES[i]] = (keys >> i) & 1;
+    }
+
+    return tickKeyStates;
+}
+
+void PlayState::keyPressed(const SDL_Event & e) {
+    if(e.type != SDL_KEYDOWN || e.key.repeat) return;
+
+    for(unsigned int i = 0; i < std::size(REPLAY_SCANCODES); i++) {
+        if(e.key.keysym.scancode == REPLAY_SCANCODES[i]) pressedKeys |= 1 << i;
+    }
 }
 
 void PlayState::exitState() {
@@ -50,8 +158,24 @@ void PlayState::exitState() {
 }
 
 void PlayState::handleEvents(MemSwap * game, const SDL_Event & e) {
+    PROFILE_ZONE("PlayState::handleEvents");
+
     if(!levelComplete) {
-        const Uint8 * keyStates = SDL_GetKeyboardState(NULL);
+        uint8_t keys = 0;
+
+        // play back recorded keys in place of the keyboard/record the keyboard
+        if(playback.get()) {
+            if(!playback->nextKeys(keys)) {
+                finishPlayback(game);
+                return;
+            }
+        } else {
+            keys = toReplayKeys(SDL_GetKeyboardState(NULL)) | pressedKeys;
+            if(recording) recorded.recordTick(keys);
+        }
+
+        pressedKeys = 0;
+        const Uint8 * keyStates = toKeyStates(keys);
 
         // Check for level reset (cannot reset on default position)
         if(level.getTilesFlipped() != 0 && keyStates[SDL_SCANCODE_R]) {
@@ -61,16 +185,30 @@ void PlayState::handleEvents(MemSwap * game, const SDL_Event & e) {
             currNumResets++;
 
             // fade out, reset, fade in
-            fade(game->getRenderer(), game, false);
-            level.reset(game);
-            fade(game->getRenderer(), game, true);
+            game->startFade([this]() {
+                level.step(INPUT_RESET);
+                levelView.sync(level);
+            });
         } else if(keyStates[SDL_SCANCODE_ESCAPE]) {
             // Check for pause
             game->setPaused(true);
             game->playSound(ACTIVATE_SOUND_ID);
         }
 
-        level.handleEvents(keyStates);
+        // check for hint request ('h'), once per press
+        if(keyStates[SDL_SCANCODE_H]) {
+            if(!hintKeyHeld) requestHint(game);
+            hintKeyHeld = true;
+        } else {
+            hintKeyHeld = false;
+        }
+
+        levelView.handleEvents(level, keyStates);
+
+        // moving on from the hinted state makes the hint (or its search) stale
+        if((hintPending || showingHint) && level.getHash() != hintHash) {
+            clearHint();
+        }
     } else {
         // Handle user selecting advance option after completing a level
         postGameButtons.at(currButton).handleEvents(e);
@@ -93,6 +231,9 @@ void PlayState::handleEvents(MemSwap * game, const SDL_Event & e) {
 }
 
 void PlayState::updateStats(MemSwap * game) {
+    // replays played back don't count towards the player's stats
+    if(game->getPlayback().get()) return;
+
     // update profile data after each level complete
     currTilesFlipped += level.getTilesFlipped();
     level.setTilesFlipped(0);
@@ -109,6 +250,8 @@ void PlayState::updateStats(MemSwap * game) {
 }
  
 void PlayState::update(MemSwap * game, float delta) {
+    PROFILE_ZONE("PlayState::update");
+
     // if paused update stats and set pause state
     if(game->isPaused()) {
         updateStats(game);
@@ -124,21 +267,84 @@ void PlayState::update(MemSwap * game, float delta) {
             handlePGActivation(game);
         }
     } else {
-        level.update(delta);
+        levelView.update(delta);
+
+        // pick up the hint once found (without waiting on the search)
+        if(hintPending && hintEngine.poll(currHint)) {
+            hintPending = false;
+            hintLatency = currHint.latency;
+            showingHint = currHint.stateHash == level.getHash();
+
+            if(showingHint) {
+                levelView.showHint(level, currHint.move);
+                layoutHintText();
+            }
+        }
 
         // check if level is succesfully completed and animation has finished
-        levelComplete = level.isCompleted();
+        levelComplete = level.isCompleted() && !levelView.isAnimating();
 
         // update stats 1x
         if(levelComplete) {
+            finishRecording();
+
+            if(playback.get()) {
+                finishPlayback(game);
+                return;
+            }
+
             postGameButtons.front().setFocus(true);
             updateStats(game);
 
             game->playSound(COMPLETE_SOUND_ID);
+
+            // load the next level while the postgame board is up
+            std::string nextLevelID = game->getNextLevelID();
+            if(!nextLevelID.empty()) {
+                levelLoader.prefetch(game->getResManager().getResPath(nextLevelID));
+            }
         }
     }
 }
 
+// search for the next move from the level's current state
+void PlayState::requestHint(MemSwap * game) {
+    if(level.isCompleted() || !level.getPlayer()) return;
+
+    clearHint();
+    hintEngine.request(level);
+    hintHash = level.getHash();
+    hintPending = true;
+
+    game->playSound(SWITCH_SOUND_ID);
+}
+
+// lay out what the hint found, and how long it took, once it's found
+void PlayState::layoutHintText() {
+    char text[HINT_TEXT_MAX];
+
+    if(currHint.move != INPUT_NONE) {
+        snprintf(text, sizeof(text), "Hint: %d ms", (int)(currHint.latency + 0.5));
+    } else if(currHint.unsolvable) {
+        snprintf(text, sizeof(text), "%s", UNSOLVABLE_TEXT.c_str());
+    } else if(currHint.capped) {
+        snprintf(text, sizeof(text), "%s", CAPPED_TEXT.c_str());
+    } else {
+        snprintf(text, sizeof(text), "%s", NO_HINT_TEXT.c_str());
+    }
+
+    hintGlyphs.clear();
+    hintFont->layoutText(text, HINT_TEXT_PAD, HINT_TEXT_PAD, hintGlyphs);
+}
+
+void PlayState::clearHint() {
+    if(hintPending) hintEngine.cancel();
+
+    hintPending = false;
+    showingHint = false;
+    levelView.clearHint();
+}
+
 /// handle postgame button activations
 void PlayState::handlePGActivation(MemSwap * game) {
     switch(currButton) {
@@ -163,7 +369,14 @@ void PlayState::handlePGActivation(MemSwap * game) {
 
 /// Render function for the game state
 void PlayState::render(SDL_Renderer * renderer) const {
-    level.render(renderer);
+    PROFILE_ZONE("PlayState::render");
+
+    levelView.render(renderer);
+
+    if(showingHint && !levelComplete) {
+        hintFont->setFontColor(hintColor);
+        hintFont->renderGlyphs(renderer, hintGlyphs);
+    }
 
     // render postgame board over level if level is completed
     if(levelComplete) {
@@ -175,6 +388,26 @@ void PlayState::render(SDL_Renderer * renderer) const {
     }
 }
 
+// idle while the level isn't playing anything back/searching for a hint
+// (the postgame board's focused button pulses)
+bool PlayState::isIdle() const {
+    return !levelComplete && !hintPending && levelView.isIdle();
+}
+
 bool PlayState::levelIsComplete() const {
     return levelComplete;
-}
\ No newline at end of file
+}
+
+int PlayState::getEntityCount() const {
+    int count = 0;
+
+    for(auto & entity: level.getMap().getEntities()) {
+        if(!entity->isVanished()) count++;
+    }
+
+    return count;
+}
+
+double PlayState::getHintLatency() const {
+    return hintLatency;
+}
@@ -11,7 +11,9 @@
 
 #include "memswap.hpp"
 #include "gameStates/splashstate.hpp"
+#include "utils/profiler.hpp"
 #include "utils/resmanager.hpp"
+#include "utils/spritebatch.hpp"
 
 SplashState::SplashState() : GameState(GAME_STATE_SPLASH) {}
 
@@ -28,6 +30,13 @@ void SplashState::enterState(MemSwap * game) {
 
     splashAnim.setCurrAnimation(loadingAnimation);
     splashAnim.start();
+
+    progressX = game->getScreenWidth() / 2 - PROGRESS_WIDTH / 2;
+    progressY = loadY + loadingAnimation->getFrameHeight() + PROGRESS_PAD;
+    progressColor = game->getButtonTextColor();
+
+    // decode the rest in the background
+    game->startLoadingResources();
 }
 
 void SplashState::exitState() {
@@ -39,19 +48,24 @@ void SplashState::exitState() {
 
 // Events to handle during splash screen
 void SplashState::handleEvents(MemSwap * game, const SDL_Event & e) {
+    PROFILE_ZONE("SplashState::handleEvents");
+
     if(e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_RETURN) {
         advance = true;
     }
 }
 
 void SplashState::update(MemSwap * game, float delta) {
+    PROFILE_ZONE("SplashState::update");
+
     // Continue loading resources until finished
     if(loadingRes) {
-        game->loadNextResource();
+        game->uploadLoadedResources();
         loadingRes = game->getResManager().loadingResources();
+        loadProgress = game->getResManager().getLoadProgress();
 
-        // retrieve font once it's loaded
-        if(!splashFont.get()) {
+        // retrieve font once it's loaded (fonts are loaded first)
+        if(!splashFont.get() && game->getResManager().hasFont(FONT_ID)) {
             splashFont = game->getResManager().getFont(FONT_ID);
             splashFont->setFontColor(game->getButtonTextColor());
 
@@ -62,7 +76,7 @@ void SplashState::update(MemSwap * game, float delta) {
 
             splashFont->initRenderDynamicText(advTextX, advTextY, LOADING_TEXT, 
                 !TYPED, FLASHING);
-        } else {
+        } else if(splashFont.get()) {
             splashFont->updateText(delta);
         }
 
@@ -71,7 +85,10 @@ void SplashState::update(MemSwap * game, float delta) {
         }
 
     } else {
-        if (advance) {
+        if(game->getPlayback().get()) {
+            // go straight to the replay's level when playing one back
+            game->setNextState(GAME_STATE_PLAY);
+        } else if (advance) {
             // Otherwise finish the SPLASH state and set next as the MENU state
             game->setNextState(GAME_STATE_MENU);
         }
@@ -95,11 +112,28 @@ void SplashState::update(MemSwap * game, float delta) {
 
 /// Render function for the game state
 void SplashState::render(SDL_Renderer * renderer) const {
+    PROFILE_ZONE("SplashState::render");
+
     // Render background
     bgTexture.render(0, 0, renderer);
 
     splashAnim.render(loadX, loadY, renderer);
 
+    // progress bar while loading
+    if(loadingRes) {
+        SpriteBatch::flush();
+
+        SDL_Color drawColor;
+        SDL_GetRenderDrawColor(renderer, &drawColor.r, &drawColor.g, &drawColor.b, &drawColor.a);
+
+        SDL_Rect bar = {progressX, progressY, (int)(PROGRESS_WIDTH * loadProgress),
+            PROGRESS_HEIGHT};
+        SDL_SetRenderDrawColor(renderer, progressColor.r, progressColor.g, progressColor.b, 0xFF);
+        SDL_RenderFillRect(renderer, &bar);
+
+        SDL_SetRenderDrawColor(renderer, drawColor.r, drawColor.g, drawColor.b, drawColor.a);
+    }
+
     // Render graphic indicating loading is done, or 'loading text'
     if(splashFont.get() && splashFont->isRenderingDynamic()) {
         splashFont->renderText(renderer);
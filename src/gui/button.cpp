@@ -1,4 +1,5 @@
 #include "gui/button.hpp"
+#include "utils/spritebatch.hpp"
 
 Button::Button(int screenX, int screenY, bool clickable, 
     std::shared_ptr<Texture> buttonSprite, SDL_Color outlineColor) : 
@@ -84,6 +85,7 @@ void Button::render(SDL_Renderer * renderer) const {
 
     // if button is in focus, draw an outline around the button
     if(inFocus) {
+        SpriteBatch::flush();
         SDL_SetRenderDrawColor(renderer, (outlineColor.r - currShift), 
             (outlineColor.g - currShift), outlineColor.b, outlineColor.a);
         SDL_RenderDrawRect(renderer, &buttonOutline);
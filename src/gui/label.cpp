@@ -13,7 +13,10 @@ Label::Label(int screenX, int screenY, std::shared_ptr<Texture> labelSprite,
     screenX(screenX), screenY(screenY),
     textX(initTextX()),
     textY(initTextY()),
-    hasText(labelFont != nullptr && labelText.length() > 0) {}
+    hasText(labelFont != nullptr && labelText.length() > 0) {
+
+    layoutText();
+}
 
 int Label::initTextX() const {
     int x = 0;
@@ -62,6 +65,11 @@ int Label::initTextY() const {
     return y;
 }
 
+void Label::layoutText() {
+    textGlyphs.clear();
+    if(hasText) labelFont->layoutText(labelText.c_str(), textX, textY, textGlyphs);
+}
+
 void Label::render(SDL_Renderer * renderer) const {
     labelSprite->render(screenX, screenY, renderer);
 
@@ -69,17 +77,18 @@ void Label::render(SDL_Renderer * renderer) const {
         graphicSprite->render(screenX, screenY, renderer);
     } else if(hasText) {
         labelFont->setFontColor(textColor);
-        labelFont->renderText(renderer, labelText, textX, textY);
+        labelFont->renderGlyphs(renderer, textGlyphs);
     }
 }
 
-std::string Label::getText() const {
+const std::string & Label::getText() const {
     return labelText;
 }
 
 void Label::setText(std::string text) {
     labelText = text;
-    hasText = text.length() > 0;
+    hasText = labelFont != nullptr && text.length() > 0;
+    layoutText();
 }
 
 int Label::getScreenX() const {
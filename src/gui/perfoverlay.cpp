@@ -0,0 +1,104 @@
+// Implementation for the performance overlay
+
+#include <algorithm>
+#include <cstdio>
+
+#include "gui/perfoverlay.hpp"
+#include "utils/spritebatch.hpp"
+
+PerfOverlay::PerfOverlay() {
+    glyphs.reserve(MAX_GLYPHS);
+}
+
+void PerfOverlay::recordFrame(float frameMs, long long allocations) {
+    uint64_t us = (uint64_t)(std::max(frameMs, 0.f) * 1000.f);
+    sessionHistogram.record(us);
+    if(shown) shownHistogram.record(us);
+
+    frameAllocations = allocations - lastAllocations;
+    lastAllocations = allocations;
+
+    renderedFrames++;
+}
+
+void PerfOverlay::update(std::shared_ptr<BitmapFont> font, int screenWidth, int drawCalls,
+    int textureSwitches, int entities, double hintMs) {
+
+    if(!shown || !font.get()) return;
+
+    Uint32 now = SDL_GetTicks();
+    if(!glyphs.empty() && now - lastRefresh < REFRESH_MS) return;
+
+    float fps = lastRefresh && now > lastRefresh ?
+        renderedFrames * 1000.f / (now - lastRefresh) : 0.f;
+    renderedFrames = 0;
+    lastRefresh = now;
+
+    this->font = font;
+
+    // (a fixed buffer, nothing allocated)
+    char text[MAX_GLYPHS];
+    int length = snprintf(text, sizeof(text), "%.0f fps\n"
+        "frame p50 %.1f p99 %.1f max %.1f ms\n"
+        "draws %d switches %d\n"
+        "entities %d allocs %lld", fps,
+        shownHistogram.percentile(0.5) / 1000.f, shownHistogram.percentile(0.99) / 1000.f,
+        shownHistogram.getMax() / 1000.f, drawCalls, textureSwitches, entities,
+        frameAllocations);
+
+    if(hintMs >= 0.0 && length > 0 && length < (int)sizeof(text)) {
+        snprintf(text + length, sizeof(text) - length, "\nhint %.0f ms", hintMs);
+    }
+
+    glyphs.clear();
+    font->layoutText(text, 0, 0, glyphs);
+
+    // align to the top right, over a backing
+    int width = 0, height = 0;
+    for(auto & glyph: glyphs) {
+        width = std::max(width, glyph.x + glyph.clip.w);
+        height = std::max(height, glyph.y + glyph.clip.h);
+    }
+
+    int offsetX = screenWidth - width - PAD * 2;
+    for(auto & glyph: glyphs) {
+        glyph.x += offsetX;
+        glyph.y += PAD;
+    }
+
+    backing = {offsetX - PAD, 0, width + PAD * 2, height + PAD * 2};
+}
+
+void PerfOverlay::render(SDL_Renderer * renderer) const {
+    if(!shown || !font.get()) return;
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0xB0);
+    SDL_RenderFillRect(renderer, &backing);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+
+    SpriteBatch::begin(renderer);
+    font->renderGlyphs(renderer, glyphs);
+    SpriteBatch::end();
+}
+
+void PerfOverlay::toggle() {
+    shown = !shown;
+
+    // percentiles from when it's shown, refreshed right away
+    if(shown) {
+        everShown = true;
+        shownHistogram = FrameHistogram();
+        glyphs.clear();
+        lastRefresh = 0;
+        renderedFrames = 0;
+    }
+}
+
+bool PerfOverlay::isShown() const {
+    return shown;
+}
+
+void PerfOverlay::saveHistogram(const std::string & path) const {
+    if(everShown) sessionHistogram.save(path);
+}
@@ -1,93 +1,335 @@
 // Implementation for level class
 
-#include "memswap.hpp"
+#include <algorithm>
+
 #include "level/level.hpp"
+#include "level/replay.hpp"
+#include "entities/player.hpp"
 #include "entities/portal.hpp"
+#include "utils/profiler.hpp"
+
+Level::Level() {
+    events.reserve(EVENTS_RESERVED);
+}
+
+Level::Level(std::string tiledMapPath)
+    : map(tiledMapPath, this), mapPath(tiledMapPath) {
+    events.reserve(EVENTS_RESERVED);
+    map.saveState(initialState);
+    collapseState = initialState;
+    rehashEntities();
+}
+
+// advance the simulation by a single input
+bool Level::step(SimInput input) {
+    PROFILE_ZONE("Level::step");
+
+    events.clear();
+
+    if(recorder) recorder->recordStep(input);
+
+    switch(input) {
+        case INPUT_NONE:
+            return false;
+        case INPUT_UNDO:
+            return undo();
+        case INPUT_RESET:
+            reset();
+            return true;
+        default:
+            break;
+    }
+
+    Player * player = map.getPlayer();
+    if(completed || !player || player->isMerging()) return false;
+
+    // log the changes made by the move, for undo
+    undoLog.beginStep(getHash());
+
+    player->move(this, inputDirection(input));
+
+    // if nothing moved (eg. bumped into a wall) this isn't a move of its own,
+    // any changes it made (eg. the player's last portal) are undone with the
+    // move before it (or on their own, if there's no move before it)
+    bool changed = std::any_of(events.begin(), events.end(),
+        [](const SimEvent & event) { return event.type != EVENT_BONK; });
+
+    if(!changed) {
+        undoLog.mergeStep();
+        return false;
+    }
+
+    // once the player has merged with its receptor, check for completion
+    if(player->isMerging() && checkComplete()) {
+        addEvent({EVENT_COMPLETE, player->getEntityID(), -1, 0, 0, 0, 0, 0});
+    }
+
+    // returning to a state from earlier in the log drops the moves made since,
+    // so undo steps back past the detour
+    collapseUndo();
+
+    return true;
+}
+
+// undo the last move (counts against perfect play even with nothing to undo)
+bool Level::undo() {
+    if(completed) return false;
+
+    movesUndone++;
+    perfect = false;
+
+    if(undoLog.getStepCount() == 0) return false;
+
+    // reverse the last move's changes, newest first, back to its start
+    while(undoLog.getRecordCount() > 0) {
+        UndoRecord record = undoLog.pop();
+        if(record.type == UNDO_STEP) break;
+
+        revert(record);
+    }
+
+    return true;
+}
+
+// drop the moves since the earliest one that started from the current state.
+// The hash only finds the candidate: the moves since are reverted and the
+// result compared to the current state, so a hash collision keeps the moves
+// rather than leaving undo to restore a state that doesn't match the board
+void Level::collapseUndo() {
+    uint64_t step;
+    if(!undoLog.findStep(getHash(), step)) return;
 
-Level::Level() {}
+    map.saveState(collapseState);
 
-Level::Level(std::string tiledMapPath, SDL_Renderer * renderer, MemSwap * game) 
-    : mGame(game), map(tiledMapPath, renderer, this, game), mapPath(tiledMapPath) {}
+    for(uint64_t i = undoLog.getEnd(); i-- > step;) {
+        revert(undoLog.getRecord(i));
+    }
 
-// Event loop (down right)
-void Level::handleEvents(const Uint8 * keyStates) {
-    map.handleEvents(this, keyStates);
+    if(map.matchesState(collapseState)) {
+        undoLog.truncate(step);
+    } else {
+        map.loadState(collapseState);
+        rehashEntities();
+    }
 }
 
-// Update loop
-void Level::update(float delta) {
-    if(!completed) {
-        // Update the map if not completed
-        map.update(this, delta);
+void Level::revert(const UndoRecord & record) {
+    auto & entities = map.getEntities();
+    auto coords = map.indexToXY(record.index);
+
+    switch(record.type) {
+        case UNDO_FLIP:
+            map.setTileParity(coords.first, coords.second, (Parity)record.value);
+            break;
+        case UNDO_MOVE: {
+            auto toCoords = map.indexToXY(record.data);
+            map.moveGridElement(toCoords.first, toCoords.second, coords.first, coords.second);
+
+            if(record.entityID != Map::NO_ENTITY) {
+                map.placeGridElement(entities[record.entityID], toCoords.first, toCoords.second);
+            }
+            break;
+        }
+        case UNDO_CELL:
+            if(record.entityID != Map::NO_ENTITY) {
+                map.placeGridElement(entities[record.entityID], coords.first, coords.second);
+            } else {
+                map.removeGridElement(coords.first, coords.second);
+            }
+            break;
+        case UNDO_VANISH: {
+            Entity * entity = entities[record.entityID].get();
+
+            entityHash ^= vanishedKey(entity);
+            entity->setVanished(record.value);
+            entityHash ^= vanishedKey(entity);
+            break;
+        }
+        case UNDO_LINK: {
+            auto & player = static_cast<Player &>(*entities[record.entityID]);
+            Portal * portal = record.index != Map::NO_ENTITY ?
+                static_cast<Portal *>(entities[record.index].get()) : nullptr;
+
+            entityHash ^= linkKey(player.getLastPortal()) ^ linkKey(portal);
+            player.setLastPortal(portal);
+            break;
+        }
+        case UNDO_PORTALS:
+            if(record.value) {
+                map.removePortals();
+            } else {
+                map.placePortals();
+            }
+            break;
+        default:
+            break;
     }
 }
 
-void Level::render(SDL_Renderer * renderer) const {
-    // Render the map
-    map.render(renderer); 
+void Level::saveState(MapState & state) const {
+    map.saveState(state);
+}
+
+void Level::loadState(const MapState & state) {
+    map.loadState(state);
+    rehashEntities();
+    undoLog.clear();
+    events.clear();
+
+    Player * player = map.getPlayer();
+    completed = player && player->isMerging() && map.allTilesPurple();
+}
+
+Direction Level::inputDirection(SimInput input) {
+    switch(input) {
+        case INPUT_UP:      return DIR_UP;
+        case INPUT_DOWN:    return DIR_DOWN;
+        case INPUT_LEFT:    return DIR_LEFT;
+        case INPUT_RIGHT:   return DIR_RIGHT;
+        default:            return DIR_NONE;
+    }
 }
 
 // Update size from the given map
 void Level::updateSize(const tmx::Map & map, int tileWidth, int tileHeight) {
     auto map_dimensions = map.getTileCount();
 
-    gridWidth = map_dimensions.x;
-    gridHeight = map_dimensions.y;
+    updateSize(map_dimensions.x, map_dimensions.y, tileWidth, tileHeight);
+}
+
+void Level::updateSize(int gridWidth, int gridHeight, int tileWidth, int tileHeight) {
+    this->gridWidth = gridWidth;
+    this->gridHeight = gridHeight;
 
     pixelWidth = tileWidth * gridWidth;
     pixelHeight = tileHeight * gridHeight;
 }
 
 // flip tiles in the map for the specified movement
-void Level::flipMapTiles(int movedFromX, int movedFromY, int entityParity, bool undo) {
-    map.flipTile(movedFromX, movedFromY, entityParity, this, undo);
+void Level::flipMapTiles(int movedFromX, int movedFromY, int entityParity) {
+    Parity parity = map.getTileParity(movedFromX, movedFromY);
+    map.flipTile(movedFromX, movedFromY, entityParity, this);
+
+    if(map.getTileParity(movedFromX, movedFromY) != parity) {
+        undoLog.push({UNDO_FLIP, (uint8_t)parity, -1,
+            map.xyToIndex(movedFromX, movedFromY), 0});
+    }
 }
 
 // Move a grid element from start x,y to end
 void Level::moveGridElement(int startX, int startY, int endX, int endY) {
+    if(!map.inBounds(startX, startY) || !map.inBounds(endX, endY)) return;
+
+    undoLog.push({UNDO_MOVE, 0, map.getGridEntityID(endX, endY),
+        map.xyToIndex(startX, startY), (uint64_t)map.xyToIndex(endX, endY)});
     map.moveGridElement(startX, startY, endX, endY);
 }
 
 void Level::placeGridElement(std::shared_ptr<Entity> entity, int x, int y) {
+    if(!map.inBounds(x, y)) return;
+
+    undoLog.push({UNDO_CELL, 0, map.getGridEntityID(x, y), map.xyToIndex(x, y), 0});
     map.placeGridElement(entity, x, y);
 }
 
 void Level::removeGridElement(int x, int y) {
+    if(!map.inBounds(x, y)) return;
+
+    undoLog.push({UNDO_CELL, 0, map.getGridEntityID(x, y), map.xyToIndex(x, y), 0});
     map.removeGridElement(x, y);
 }
 
+void Level::setVanished(Entity * entity, bool vanished) {
+    undoLog.push({UNDO_VANISH, entity->isVanished(), entity->getEntityID(), 0, 0});
+
+    entityHash ^= vanishedKey(entity);
+    entity->setVanished(vanished);
+    entityHash ^= vanishedKey(entity);
+}
+
+void Level::setLastPortal(Player * player, Portal * portal) {
+    Portal * lastPortal = player->getLastPortal();
+
+    undoLog.push({UNDO_LINK, 0, player->getEntityID(),
+        lastPortal ? lastPortal->getEntityID() : Map::NO_ENTITY, 0});
+
+    entityHash ^= linkKey(lastPortal) ^ linkKey(portal);
+    player->setLastPortal(portal);
+}
+
+uint64_t Level::linkKey(const Entity * portal) {
+    return portal ? zobristFlagKey(LINK_FLAG + portal->getEntityID()) : 0;
+}
+
+uint64_t Level::vanishedKey(const Entity * entity) {
+    return entity->isVanished() ? zobristFlagKey(VANISHED_FLAG + entity->getEntityID()) : 0;
+}
+
+// rebuild the entity hash from scratch (after loading a state)
+void Level::rehashEntities() {
+    entityHash = 0;
+
+    for(auto & entity: map.getEntities()) {
+        entityHash ^= vanishedKey(entity.get());
+    }
+
+    Player * player = map.getPlayer();
+    if(player) entityHash ^= linkKey(player->getLastPortal());
+}
+
+// temporarily lift portals from the grid
+void Level::removePortals() {
+    undoLog.push({UNDO_PORTALS, map.arePortalsRemoved(), -1, 0, 0});
+    map.removePortals();
+}
+
 // place portals back in grid
-void Level::placePortals() {
-    map.placePortals();
+bool Level::placePortals() {
+    bool removed = map.arePortalsRemoved();
+    if(!map.placePortals()) return false;
+
+    undoLog.push({UNDO_PORTALS, removed, -1, 0, 0});
+    return true;
+}
+
+bool Level::portalsRemoved() const {
+    return map.arePortalsRemoved();
 }
 
 // check if the level is complete
 bool Level::checkComplete() {
-    // check if each tile parity matches purple parity
-    for(int y = 0; y < gridHeight; y++) {
-        for(int x = 0; x < gridWidth; x++) {
-            // if some tile isn't flipped, level has not been succesfully completed
-            if(getTileParity(x, y) != PARITY_PURPLE) {
-                return false;
-            }
-        }
-    }
+    // if some tile isn't flipped, level has not been succesfully completed
+    if(!map.allTilesPurple()) return false;
 
     completed = true;
     return true;
 }
 
-void Level::reset(MemSwap * game) {
-    // clear and reload the map tiles/entities
-    map.clear();
-    map.loadMap(mapPath, game->getRenderer(), this, game);
+void Level::reset() {
+    PROFILE_ZONE("Level::reset");
+
+    // restore the tiles/entities as loaded (no allocations, the map is the
+    // same size)
+    map.loadState(initialState);
+    rehashEntities();
+    undoLog.clear();
 
     tilesFlipped = 0;
+    movesUndone = 0;
+    completed = false;
     perfect = false;
 }
 
-void Level::playSound(std::string soundID) const {
-    mGame->playSound(soundID);
+void Level::setRecorder(Replay * recorder) {
+    this->recorder = recorder;
+}
+
+void Level::addEvent(const SimEvent & event) {
+    events.push_back(event);
+}
+
+const std::vector<SimEvent> & Level::getEvents() const {
+    return events;
 }
 
 bool Level::isCompleted() const {
@@ -102,19 +344,19 @@ void Level::setPerfect(bool perfect) {
     this->perfect = perfect;
 }
 
-int Level::getGridWidth() const { 
+int Level::getGridWidth() const {
     return gridWidth;
 }
 
-int Level::getGridHeight() const { 
+int Level::getGridHeight() const {
     return gridHeight;
 }
 
-int Level::getPixelWidth() const { 
+int Level::getPixelWidth() const {
     return pixelWidth;
 }
 
-int Level::getPixelHeight() const { 
+int Level::getPixelHeight() const {
     return pixelHeight;
 }
 
@@ -131,7 +373,7 @@ void Level::setTilesFlipped(int tiles) {
 }
 
 int Level::getMovesUndone() const {
-    return map.getMovesUndone();
+    return movesUndone;
 }
 
 bool Level::inBounds(int x, int y) const {
@@ -142,6 +384,22 @@ Parity Level::getTileParity(int x, int y) const {
     return map.getTileParity(x, y);
 }
 
-std::shared_ptr<Player> Level::getPlayer() const {
+Player * Level::getPlayer() const {
     return map.getPlayer();
-}
\ No newline at end of file
+}
+
+int Level::getUndoCount() const {
+    return undoLog.getStepCount();
+}
+
+const UndoLog & Level::getUndoLog() const {
+    return undoLog;
+}
+
+const Map & Level::getMap() const {
+    return map;
+}
+
+const std::string & Level::getMapPath() const {
+    return mapPath;
+}
@@ -0,0 +1,24 @@
+// Implementation for the background level loader
+
+#include "level/levelloader.hpp"
+#include "utils/profiler.hpp"
+
+LevelLoader::LevelLoader() {}
+
+void LevelLoader::prefetch(const std::string & path) {
+    if(prefetched.valid() && prefetchPath == path) return;
+
+    prefetchPath = path;
+    prefetched = std::async(std::launch::async, [path]() {
+        PROFILE_ZONE("LevelLoader::prefetch");
+        return Level(path);
+    });
+}
+
+bool LevelLoader::take(const std::string & path, Level & level) {
+    if(!prefetched.valid() || prefetchPath != path) return false;
+
+    level = prefetched.get();
+    prefetchPath.clear();
+    return true;
+}
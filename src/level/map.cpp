@@ -1,6 +1,8 @@
 // Implementation for map class
 
-#include "memswap.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 
 #include "entities/player.hpp"
 #include "entities/diamond.hpp"
@@ -9,87 +11,53 @@
 #include "entities/portal.hpp"
 
 #include "level/level.hpp"
+#include "level/levelfile.hpp"
 #include "level/map.hpp"
+#include "utils/mappedfile.hpp"
 
 
 // constructors
 Map::Map() {}
-Map::Map(std::string tiledMapPath, SDL_Renderer * renderer, Level * level,
-    MemSwap * game) {
-    loadMap(tiledMapPath, renderer, level, game);
+Map::Map(std::string tiledMapPath, Level * level) {
+    loadMap(tiledMapPath, level);
 }
 
-// handle events (top left -> down right)
-void Map::handleEvents(Level * level, const Uint8 * keyStates) {
-    for(int y = 0; y < mapHeight; y++) {
-        for(int x = 0; x < mapWidth; x++) {
-            int currIdx = xyToIndex(x,y);
-            if(entityGrid.at(currIdx)) {
-                entityGrid.at(currIdx)->handleEvents(keyStates, level);
-            }
-        }
-    }
-}
-
-// Update each tile in the map
-void Map::update(Level * level, float delta) {
-    for(Tile & tile: mapTiles) {
-        tile.update(level, delta);
-    }
-
-    // if level has portals and they're removed, update manually
-    if(!mapPortals.empty() && mapPortals.back()->isRemoved()) {
-        for(auto & portal: mapPortals) {
-            portal->update(level, delta);
-        }
-    }
-    
-    // Update the entities
-    for(int y = 0; y < mapHeight; y++) {
-        for(int x = 0; x < mapWidth; x++) {
-            int currIdx = xyToIndex(x,y);
-            if(entityGrid.at(currIdx)) {
-                entityGrid.at(currIdx)->update(level, delta);
-            }
-        }
-    }
-}
-
-void Map::render(SDL_Renderer * renderer) const {
-    // Render the background tiles
-    for(const Tile & tile: mapTiles) {
-        tile.render(renderer);
-    }
-
-    // render portals manually if tmp. removed
-    if(!mapPortals.empty() && mapPortals.back()->isRemoved()) {
-        for(auto & portal: mapPortals) {
-            portal->render(renderer);
-        }
-    }
-    
-    // Render the entities in the grid
-    for(int y = 0; y < mapHeight; y++) {
-        for(int x = 0; x < mapWidth; x++) {
-            int currIdx = xyToIndex(x,y);
-            if(entityGrid.at(currIdx)) {
-                entityGrid.at(currIdx)->render(renderer);
-            }
-        }
-    }    
-}
-
-
 // clear the map
 void Map::clear() {
-    mapTiles.clear();
+    tileParities.clear();
+    tileGIDs.clear();
     entityGrid.clear();
+    gridHash = 0;
+    mapEntities.clear();
+    entityGIDs.clear();
+    tilesetProperties.clear();
+    tilesetNames.clear();
     mapPortals.clear();
+    mapPlayer.reset();
+
+    usesPortals = false;
+    portalsRemoved = false;
 }
 
 // Load the map for the given level
-void Map::loadMap(std::string tiledMapPath, SDL_Renderer * renderer,
-    Level * level, MemSwap * game) {
+void Map::loadMap(std::string mapPath, Level * level) {
+    if(mapPath.size() >= COMPILED_MAP_EXT.size() && mapPath.compare(
+        mapPath.size() - COMPILED_MAP_EXT.size(), COMPILED_MAP_EXT.size(), COMPILED_MAP_EXT) == 0) {
+        if(!loadCompiledMap(mapPath, level)) {
+            // stale/corrupt file, fall back to the tiledmap it was compiled from
+            printf("Failed to load compiled map %s, loading the tiledmap\n", mapPath.c_str());
+
+            clear();
+            loadTiledMap(mapPath.substr(0, mapPath.size() - COMPILED_MAP_EXT.size()) +
+                TILED_MAP_EXT, level);
+        }
+    } else {
+        loadTiledMap(mapPath, level);
+    }
+}
+
+// Load the map from a tiledmap
+void Map::loadTiledMap(std::string tiledMapPath, Level * level) {
     tmx::Map map;
 
     if(map.load(tiledMapPath)) {
@@ -97,17 +65,17 @@ void Map::loadMap(std::string tiledMapPath, SDL_Renderer * renderer,
         auto tilesize = map.getTileSize();
         tileWidth = tilesize.x;
         tileHeight = tilesize.y;
-        
+
         level->updateSize(map, tileWidth, tileHeight);
         mapWidth = level->getGridWidth();
         mapHeight = level->getGridHeight();
 
-        // retrieve pre-loaded spritesheets for the tilesets used in this map
-        for(auto & tileset: map.getTilesets()) {
-            std::string tilesetName = tileset.getName();
-            auto ssPtr = game->getResManager().getSpriteSheet(tilesetName);
+        initGrid();
 
-            mapSpritesheets.emplace(tileset.getFirstGID(), ssPtr);
+        // read the tile properties of the tilesets used in this map
+        for(auto & tileset: map.getTilesets()) {
+            tilesetProperties.emplace(tileset.getFirstGID(), TileProperties(tileset));
+            tilesetNames.emplace(tileset.getFirstGID(), tileset.getName());
         }
 
         // Get data from each map layer, create necessary tiles/objects
@@ -118,158 +86,149 @@ void Map::loadMap(std::string tiledMapPath, SDL_Renderer * renderer,
             }
 
             auto * tileLayer = dynamic_cast<const tmx::TileLayer*>(layer.get());
-            
+
             // process tiles differently depending on the layer we're on
-            addTiles(tileLayer, level, game, layer->getName());
+            addTiles(tileLayer, layer->getName());
         }
     }
 }
 
 // Add tiles to the map
-void Map::addTiles(const tmx::TileLayer * tileLayer, Level * level, 
-    MemSwap * game, std::string layerName) {
-    
+void Map::addTiles(const tmx::TileLayer * tileLayer, std::string layerName) {
     auto & layerTiles = tileLayer->getTiles();
 
-    // Compute where to start placing tiles, given map size (center the map)
-    renderX = (game->getScreenWidth() / 2) - (mapWidth * tileWidth / 2);
-    renderY = (game->getScreenHeight() / 2) - (mapHeight * tileHeight / 2);            
-            
     // Iterate through each tile in this layer (top left corner -> down right)
     for(int y = 0; y < mapHeight; y++) {
         for(int x = 0; x < mapWidth; x++) {
-            int tileIndex = xyToIndex(x,y);
-
             // Get the GID for the current tile in this layer
-            int tileGID = layerTiles[tileIndex].ID;
-
-            // get tileset's firstGID (greatest ID <= ours)
-            int tilesetFirstGID = -1;
-            for(auto & spritesheet: mapSpritesheets) {
-                int currFirstGID = spritesheet.first;
-                if(currFirstGID <= tileGID &&  currFirstGID > tilesetFirstGID) {
-                    tilesetFirstGID = currFirstGID;
-                }
-            }
-
-            // no tileset found
-            if(tilesetFirstGID == -1) continue;
-
-            // normalize ID to the BG spritesheet
-            int tileID = tileGID - tilesetFirstGID;
-
-            // Get position of tile in the map, centered for the given map size 
-            auto screenX = renderX + x * tileWidth;
-            auto screenY = renderY + y * tileHeight;
-
-            // Get the spritesheet of the tile
-            auto & tileSpritesheet = mapSpritesheets.at(tilesetFirstGID);
+            int tileGID = layerTiles[xyToIndex(x,y)].ID;
 
             // Depending on the type of layer we're loading, process differently
             if(layerName == BG_LAYER_NAME) {
-                addBGTile(screenX, screenY, tileID, tileSpritesheet, game);
+                addBGTile(tileGID);
             } else if(layerName == ENTITY_LAYER_NAME) {
-                // initialize grid before loading first entity
-                if(entityGrid.size() == 0) initGrid();
-
-                addEntity(screenX, screenY, x, y, tileID, tileSpritesheet, game);
+                addEntity(x, y, tileGID);
             }
         }
     }
 }
 
 // add a given bg tile
-void Map::addBGTile(int screenX, int screenY, int tileID, 
-    const std::shared_ptr<SpriteSheet> & spritesheet, MemSwap * game) {
-    
-    // Get parity of the BG Tile from spritesheet properties
-    int tileParity = spritesheet->getPropertyValue<int>(tileID, PARITY_PROP);
-    
-    // add to parityTileIDs if not yet complete
-    if(parityTileSprites.size() < 2) {
-        parityTileSprites.emplace(tileParity, spritesheet->getSprite(tileID));
+void Map::addBGTile(int tileGID) {
+    int tilesetFirstGID = getTilesetFirstGID(tileGID);
+    Parity tileParity = PARITY_NONE;
+
+    // Get parity of the BG Tile from tileset properties
+    if(tilesetFirstGID != -1) {
+        int tileID = tileGID - tilesetFirstGID;
+        tileParity = (Parity)tilesetProperties.at(tilesetFirstGID).getPropertyValue<int>(
+            tileID, PARITY_PROP);
+    } else {
+        tileGID = 0;
     }
-    
-    // Add new tile to mapTiles
-    mapTiles.emplace_back(screenX, screenY, tileParity, 
-        spritesheet->getSprite(tileID), game->getResManager().getTileAnimations());
+
+    tileParities.push(tileParity);
+    tileGIDs.push_back(tileGID);
 }
 
-void Map::addEntity(int screenX, int screenY, int gridX, int gridY, int tileID, 
-    const std::shared_ptr<SpriteSheet> & spritesheet, MemSwap * game) {
+void Map::addEntity(int gridX, int gridY, int tileGID) {
+    int tilesetFirstGID = getTilesetFirstGID(tileGID);
+
+    // no tileset found
+    if(tilesetFirstGID == -1) return;
+
+    // normalize ID to the entity tileset
+    int tileID = tileGID - tilesetFirstGID;
+    auto & properties = tilesetProperties.at(tilesetFirstGID);
 
-    auto entitySprite = spritesheet->getSprite(tileID);
+    // skip tiles which aren't entities (eg. stray bg tiles)
+    if(!properties.hasProperty(tileID, NAME_PROP)) return;
 
     // Get name/parity of entity to determine what entity to create
-    auto entityName = spritesheet->getPropertyValue<std::string>(tileID, NAME_PROP);
-    int parity = spritesheet->getPropertyValue<int>(tileID, PARITY_PROP);
+    auto entityName = properties.getPropertyValue<std::string>(tileID, NAME_PROP);
+    int parity = properties.getPropertyValue<int>(tileID, PARITY_PROP);
 
     std::shared_ptr<Entity> newEntity;
 
     if(entityName == PLAYER_ENAME) {
-        newEntity = std::make_shared<Player>(screenX, screenY, gridX, gridY, 
-            parity, entitySprite, game->getResManager().getPlayerAnimations());
-        mapPlayer = std::dynamic_pointer_cast<Player>(newEntity);
+        newEntity = std::make_shared<Player>(gridX, gridY, parity);
     } else if(entityName == DIAMOND_ENAME) {
-        newEntity = std::make_shared<Diamond>(screenX, screenY, gridX, gridY, 
-            parity, entitySprite, game->getResManager().getDiamondAnimations());
+        newEntity = std::make_shared<Diamond>(gridX, gridY, parity);
     } else if(entityName == RECEPTOR_ENAME) {
-        auto shape = spritesheet->getPropertyValue<std::string>(tileID, SHAPE_PROP);
+        auto shape = properties.getPropertyValue<std::string>(tileID, SHAPE_PROP);
 
-        newEntity = std::make_shared<Receptor>(screenX, screenY, gridX, gridY, 
-            parity, entitySprite, shape, game->getResManager().getReceptorAnimations());
+        newEntity = std::make_shared<Receptor>(gridX, gridY, parity, shape);
     } else if(entityName == BOOST_ENAME) {
         // get direction/power properties for boost
-        int power = spritesheet->getPropertyValue<int>(tileID, POWER_PROP);
-        int direction = spritesheet->getPropertyValue<int>(tileID, DIR_PROP);
+        int power = properties.getPropertyValue<int>(tileID, POWER_PROP);
+        int direction = properties.getPropertyValue<int>(tileID, DIR_PROP);
 
-        newEntity = std::make_shared<Boost>(screenX, screenY, gridX, gridY,
-            parity, power, direction, entitySprite, game->getResManager().getBoostAnimations());
+        newEntity = std::make_shared<Boost>(gridX, gridY, parity, power, direction);
     } else if(entityName == PORTAL_ENAME && mapPortals.size() < 2) {
-        usesPortals = true;
-
-        newEntity = std::make_shared<Portal>(screenX, screenY, gridX, gridY, 
-            parity, entitySprite, game->getResManager().getPortalAnimations());
+        addPortal(std::make_shared<Portal>(gridX, gridY, parity), tileGID);
+    }
 
-        std::shared_ptr<Portal> newPortal = std::dynamic_pointer_cast<Portal>(newEntity);
+    if(newEntity.get()) {
+        addEntity(newEntity, tileGID);
+    }
+}
 
-        if(mapPortals.size() == 1) {
-            mapPortals.back()->setOtherPortal(newPortal);
-            newPortal->setOtherPortal(mapPortals.back());
-        }
+// add a portal to the map, pairing it with the first one
+void Map::addPortal(std::shared_ptr<Portal> portal, int tileGID) {
+    usesPortals = true;
 
-        mapPortals.push_back(newPortal);
+    if(mapPortals.size() == 1) {
+        mapPortals.back()->setOtherPortal(portal.get());
+        portal->setOtherPortal(mapPortals.back().get());
     }
 
-    if(newEntity.get()) {
-        entityGrid[xyToIndex(gridX, gridY)] = newEntity;
+    mapPortals.push_back(portal);
+    addEntity(portal, tileGID);
+}
+
+// add an entity to the map, placing it in the grid at its position
+void Map::addEntity(std::shared_ptr<Entity> entity, int tileGID) {
+    entity->setEntityID(mapEntities.size());
+    mapEntities.push_back(entity);
+    entityGIDs.push_back(tileGID);
+
+    // track the player in the map
+    if(entity->getKind() == ENTITY_PLAYER) {
+        mapPlayer = std::static_pointer_cast<Player>(entity);
     }
+
+    placeGridElement(entity, entity->getGridX(), entity->getGridY());
 }
 
-// init entity grid
+// init (empty) entity grid
 void Map::initGrid() {
-    for(int y = 0; y < mapHeight; y++) {
-        for(int x = 0; x < mapWidth; x++) {
-            int currIdx = xyToIndex(x,y);
-            entityGrid[currIdx] = nullptr;
-        }
-    }
+    entityGrid.assign(mapWidth * mapHeight, GridCell{ENTITY_NONE, NO_ENTITY});
+    gridHash = 0;
 }
 
-// Check if a tile at the given index is inbounds
-bool Map::inBounds(int x, int y) const {
-    return (x >= 0 && x <= mapWidth - 1) && (y >= 0 && y <= mapHeight - 1);
+// create an empty map (all gray tiles, no entities) of the given size
+void Map::initMap(int width, int height, int tileWidth, int tileHeight) {
+    clear();
+
+    mapWidth = width;
+    mapHeight = height;
+    this->tileWidth = tileWidth;
+    this->tileHeight = tileHeight;
+
+    tileParities.assign(mapWidth * mapHeight, PARITY_GRAY);
+    tileGIDs.assign(mapWidth * mapHeight, 0);
+    initGrid();
 }
 
 // Update bg tile when the specified movement occurs at the specified pos. by
 // an entity with the given parity
-void Map::flipTile(int tileX, int tileY, int entityParity, Level * level, bool undo) {
+void Map::flipTile(int tileX, int tileY, int entityParity, Level * level) {
     // Check if in bounds
     if(inBounds(tileX, tileY)) {
         int idx = xyToIndex(tileX, tileY);
 
         // skip if a portal is on this tile/is curr. removed + not vanished
-        if(!mapPortals.empty() && mapPortals.back()->isRemoved()) {
+        if(portalsRemoved) {
             for(auto & portal: mapPortals) {
                 if(idx == xyToIndex(portal->getGridX(), portal->getGridY()) &&
                    !portal->isVanished()) {
@@ -278,63 +237,301 @@ void Map::flipTile(int tileX, int tileY, int entityParity, Level * level, bool u
             }
         }
 
-        Tile & currTile = mapTiles.at(xyToIndex(tileX, tileY));
+        Parity tileParity = tileParities.get(idx);
 
         // skip if tile is parity-neutral
-        if(currTile.getParity() == PARITY_NONE) return;
+        if(tileParity == PARITY_NONE) return;
 
-        // Flip if parity differs from player's
-        if(entityParity != currTile.getParity()) {
-            currTile.flip(parityTileSprites.at(entityParity), undo);
+        // Flip if parity differs from entity's
+        if(entityParity != tileParity) {
+            tileParities.set(idx, (Parity)entityParity);
 
-            // add a flipped tile to the level count (if not an undo flip)
-            if(!undo) {
-                level->addTileFlipped();
-                level->playSound(FLIP_SOUND_ID);
-            }
+            level->addTileFlipped();
+            level->addEvent({EVENT_FLIP, -1, -1, tileX, tileY, tileX, tileY, entityParity});
         }
     }
 }
 
 void Map::moveGridElement(int startX, int startY, int endX, int endY) {
     if(inBounds(startX, startY) && inBounds(endX, endY)) {
-        auto eIdx = xyToIndex(endX, endY);
-        entityGrid[eIdx] = std::move(entityGrid[xyToIndex(startX, startY)]);
+        GridCell cell = entityGrid[xyToIndex(startX, startY)];
 
-        entityGrid[eIdx]->setGridX(endX);
-        entityGrid[eIdx]->setGridY(endY);
+        setGridCell(xyToIndex(startX, startY), GridCell{ENTITY_NONE, NO_ENTITY});
+        setGridCell(xyToIndex(endX, endY), cell);
+
+        if(cell.entityID != NO_ENTITY) {
+            mapEntities[cell.entityID]->setGridX(endX);
+            mapEntities[cell.entityID]->setGridY(endY);
+        }
     }
 }
 
 void Map::placeGridElement(std::shared_ptr<Entity> entity, int x, int y) {
     if(inBounds(x,y)) {
-        entityGrid[xyToIndex(x,y)] = entity;
+        setGridCell(xyToIndex(x,y), GridCell{entity->getKind(), entity->getEntityID()});
     }
 }
 
 void Map::removeGridElement(int x, int y) {
     if(inBounds(x,y)) {
-        entityGrid.at(xyToIndex(x,y)).reset();
+        setGridCell(xyToIndex(x,y), GridCell{ENTITY_NONE, NO_ENTITY});
     }
 }
 
-// place portals in grid
-void Map::placePortals() {
-    for(auto portal: mapPortals) {
+// temporarily lift portals from grid
+void Map::removePortals() {
+    for(auto & portal: mapPortals) {
+        removeGridElement(portal->getGridX(), portal->getGridY());
+    }
+
+    portalsRemoved = true;
+}
+
+// place portals back in grid, once nothing is standing on them
+bool Map::placePortals() {
+    for(auto & portal: mapPortals) {
+        if(entityGrid[xyToIndex(portal->getGridX(), portal->getGridY())].entityID != NO_ENTITY) {
+            return false;
+        }
+    }
+
+    for(auto & portal: mapPortals) {
         placeGridElement(portal, portal->getGridX(), portal->getGridY());
     }
+
+    portalsRemoved = false;
+    return true;
 }
 
-Parity Map::getTileParity(int x, int y) const {
+bool Map::arePortalsRemoved() const {
+    return portalsRemoved;
+}
+
+// Load the map from a compiled level (everything's resolved, so this only
+// copies tiles and constructs entities straight from the mapped file)
+bool Map::loadCompiledMap(std::string compiledMapPath, Level * level) {
+    MappedFile file;
+    if(!file.open(compiledMapPath) || file.getSize() < sizeof(LevelFileHeader)) {
+        return false;
+    }
+
+    const unsigned char * data = file.getData();
+    auto * header = reinterpret_cast<const LevelFileHeader *>(data);
+
+    if(memcmp(header->magic, LEVEL_FILE_MAGIC, sizeof(LEVEL_FILE_MAGIC)) != 0 ||
+        header->version != LEVEL_FILE_VERSION || header->width <= 0 || header->height <= 0 ||
+        (header->tileCount != 0 && header->tileCount != header->width * header->height) ||
+        header->tilesetCount < 0 || header->entityCount < 0) {
+        return false;
+    }
+
+    size_t tilesetsOffset = sizeof(LevelFileHeader);
+    size_t entitiesOffset = tilesetsOffset + header->tilesetCount * sizeof(LevelFileTileset);
+    size_t gidsOffset = entitiesOffset + header->entityCount * sizeof(LevelFileEntity);
+    size_t paritiesOffset = gidsOffset + header->tileCount * sizeof(int32_t);
+
+    if(file.getSize() != paritiesOffset + header->tileCount) return false;
+
+    auto * tilesets = reinterpret_cast<const LevelFileTileset *>(data + tilesetsOffset);
+    auto * entities = reinterpret_cast<const LevelFileEntity *>(data + entitiesOffset);
+    auto * gids = reinterpret_cast<const int32_t *>(data + gidsOffset);
+    auto * parities = data + paritiesOffset;
+
+    // update size variables
+    tileWidth = header->tileWidth;
+    tileHeight = header->tileHeight;
+
+    level->updateSize(header->width, header->height, tileWidth, tileHeight);
+    mapWidth = header->width;
+    mapHeight = header->height;
+
+    initGrid();
+
+    for(int i = 0; i < header->tilesetCount; i++) {
+        tilesetNames.emplace(tilesets[i].firstGID, std::string(tilesets[i].name,
+            strnlen(tilesets[i].name, sizeof(tilesets[i].name))));
+    }
+
+    tileGIDs.assign(gids, gids + header->tileCount);
+    for(int i = 0; i < header->tileCount; i++) {
+        tileParities.push((Parity)parities[i]);
+    }
+
+    for(int i = 0; i < header->entityCount; i++) {
+        const LevelFileEntity & entity = entities[i];
+        if(!inBounds(entity.gridX, entity.gridY)) return false;
+
+        switch(entity.kind) {
+            case ENTITY_PLAYER:
+                addEntity(std::make_shared<Player>(entity.gridX, entity.gridY, entity.parity),
+                    entity.tileGID);
+                break;
+            case ENTITY_DIAMOND:
+                addEntity(std::make_shared<Diamond>(entity.gridX, entity.gridY, entity.parity),
+                    entity.tileGID);
+                break;
+            case ENTITY_RECEPTOR:
+                addEntity(std::make_shared<Receptor>(entity.gridX, entity.gridY, entity.parity,
+                    std::string(entity.shape, strnlen(entity.shape, sizeof(entity.shape)))),
+                    entity.tileGID);
+                break;
+            case ENTITY_BOOST:
+                addEntity(std::make_shared<Boost>(entity.gridX, entity.gridY, entity.parity,
+                    entity.power, entity.direction), entity.tileGID);
+                break;
+            case ENTITY_PORTAL:
+                if(mapPortals.size() >= 2) return false;
+                addPortal(std::make_shared<Portal>(entity.gridX, entity.gridY, entity.parity),
+                    entity.tileGID);
+                break;
+            default:
+                return false;
+        }
+    }
+
+    return true;
+}
+
+// write the map as loaded to a compiled level
+bool Map::saveCompiledMap(std::string compiledMapPath) const {
+    LevelFileHeader header = {};
+    memcpy(header.magic, LEVEL_FILE_MAGIC, sizeof(LEVEL_FILE_MAGIC));
+    header.version = LEVEL_FILE_VERSION;
+    header.width = mapWidth;
+    header.height = mapHeight;
+    header.tileWidth = tileWidth;
+    header.tileHeight = tileHeight;
+    header.tileCount = tileParities.getSize();
+    header.tilesetCount = tilesetNames.size();
+    header.entityCount = mapEntities.size();
+
+    std::vector<LevelFileTileset> tilesets;
+    for(auto & tileset: tilesetNames) {
+        LevelFileTileset fileTileset = {};
+        if(tileset.second.size() >= sizeof(fileTileset.name)) return false;
+
+        fileTileset.firstGID = tileset.first;
+        memcpy(fileTileset.name, tileset.second.c_str(), tileset.second.size());
+        tilesets.push_back(fileTileset);
+    }
+
+    std::vector<LevelFileEntity> entities;
+    for(unsigned int i = 0; i < mapEntities.size(); i++) {
+        Entity * entity = mapEntities[i].get();
+
+        LevelFileEntity fileEntity = {};
+        fileEntity.gridX = entity->getGridX();
+        fileEntity.gridY = entity->getGridY();
+        fileEntity.kind = entity->getKind();
+        fileEntity.parity = entity->getParity();
+        fileEntity.tileGID = entityGIDs[i];
+
+        if(entity->getKind() == ENTITY_BOOST) {
+            auto * boost = static_cast<Boost *>(entity);
+            fileEntity.power = boost->getPower();
+            fileEntity.direction = boost->getDirection();
+        } else if(entity->getKind() == ENTITY_RECEPTOR) {
+            const std::string & shape = static_cast<Receptor *>(entity)->getShape();
+            if(shape.size() >= sizeof(fileEntity.shape)) return false;
+
+            memcpy(fileEntity.shape, shape.c_str(), shape.size());
+        }
+
+        entities.push_back(fileEntity);
+    }
+
+    std::vector<uint8_t> parities;
+    for(int i = 0; i < tileParities.getSize(); i++) {
+        parities.push_back(tileParities.get(i));
+    }
+
+    std::vector<int32_t> gids(tileGIDs.begin(), tileGIDs.end());
+
+    std::ofstream out(compiledMapPath, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(tilesets.data()),
+        tilesets.size() * sizeof(LevelFileTileset));
+    out.write(reinterpret_cast<const char *>(entities.data()),
+        entities.size() * sizeof(LevelFileEntity));
+    out.write(reinterpret_cast<const char *>(gids.data()), gids.size() * sizeof(int32_t));
+    out.write(reinterpret_cast<const char *>(parities.data()), parities.size());
+
+    return out.good();
+}
+
+// store the tile parities/entity states of the map
+void Map::saveState(MapState & state) const {
+    state.tileParities = tileParities;
+    state.entityStates.resize(mapEntities.size());
+
+    for(unsigned int i = 0; i < mapEntities.size(); i++) {
+        auto & entity = mapEntities[i];
+        EntityState & entityState = state.entityStates[i];
+
+        entity->saveState(entityState);
+        entityState.inGrid =
+            entityGrid[xyToIndex(entity->getGridX(), entity->getGridY())].entityID == (int)i;
+    }
+
+    state.portalsRemoved = portalsRemoved;
+}
+
+// restore a stored state, rebuilding the entity grid (and so its hash)
+void Map::loadState(const MapState & state) {
+    tileParities = state.tileParities;
+    initGrid();
+
+    for(unsigned int i = 0; i < mapEntities.size(); i++) {
+        auto & entity = mapEntities[i];
+        const EntityState & entityState = state.entityStates[i];
+
+        entity->loadState(entityState, mapEntities);
+        if(entityState.inGrid) {
+            placeGridElement(entity, entity->getGridX(), entity->getGridY());
+        }
+    }
+
+    portalsRemoved = state.portalsRemoved;
+}
+
+// compare against a stored state, without storing the current one
+bool Map::matchesState(const MapState & state) const {
+    if(portalsRemoved != state.portalsRemoved || tileParities != state.tileParities ||
+       mapEntities.size() != state.entityStates.size()) {
+        return false;
+    }
+
+    EntityState entityState;
+    for(unsigned int i = 0; i < mapEntities.size(); i++) {
+        auto & entity = mapEntities[i];
+        const EntityState & other = state.entityStates[i];
+
+        entity->saveState(entityState);
+        entityState.inGrid =
+            entityGrid[xyToIndex(entity->getGridX(), entity->getGridY())].entityID == (int)i;
+
+        if(entityState.gridX != other.gridX || entityState.gridY != other.gridY ||
+           entityState.vanished != other.vanished || entityState.inGrid != other.inGrid ||
+           entityState.link != other.link) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void Map::setTileParity(int x, int y, Parity parity) {
     if(inBounds(x, y)) {
-        return mapTiles.at(x + y * mapWidth).getParity();
+        tileParities.set(xyToIndex(x, y), parity);
     }
-    
-    return PARITY_NONE;
 }
 
-int Map::xyToIndex(int x, int y) const {
-    return x + y * mapWidth;
+bool Map::allTilesPurple() const {
+    return tileParities.isAllPurple();
+}
+
+const ParityPlane & Map::getTileParities() const {
+    return tileParities;
 }
 
 std::pair<int, int> Map::indexToXY(int index) const {
@@ -343,22 +540,55 @@ std::pair<int, int> Map::indexToXY(int index) const {
     return std::make_pair(x,y);
 }
 
-bool Map::hasPortals() const {
-    return usesPortals;
+int Map::getTilesetFirstGID(int tileGID) const {
+    // get tileset's firstGID (greatest ID <= ours)
+    int tilesetFirstGID = -1;
+    for(auto & tileset: tilesetNames) {
+        int currFirstGID = tileset.first;
+        if(currFirstGID <= tileGID && currFirstGID > tilesetFirstGID) {
+            tilesetFirstGID = currFirstGID;
+        }
+    }
+
+    return tilesetFirstGID;
+}
+
+const std::string & Map::getTilesetName(int firstGID) const {
+    return tilesetNames.at(firstGID);
+}
+
+int Map::getTileGID(int x, int y) const {
+    return tileGIDs.at(xyToIndex(x, y));
+}
+
+int Map::getEntityGID(int entityID) const {
+    return entityGIDs.at(entityID);
 }
 
-int Map::getRenderX() const {
-    return renderX;
+int Map::getWidth() const {
+    return mapWidth;
 }
 
-int Map::getRenderY() const {
-    return renderY;
+int Map::getHeight() const {
+    return mapHeight;
 }
 
-std::shared_ptr<Player> Map::getPlayer() const {
-    return mapPlayer;
+int Map::getTileWidth() const {
+    return tileWidth;
 }
 
-int Map::getMovesUndone() const {
-    return mapPlayer->getMovesUndone();
-}
\ No newline at end of file
+int Map::getTileHeight() const {
+    return tileHeight;
+}
+
+bool Map::hasPortals() const {
+    return usesPortals;
+}
+
+const std::vector<std::shared_ptr<Entity>> & Map::getEntities() const {
+    return mapEntities;
+}
+
+Player * Map::getPlayer() const {
+    return mapPlayer.get();
+}
@@ -0,0 +1,106 @@
+// Implementation for the tile parity bit planes
+
+#include "level/parityplane.hpp"
+
+void ParityPlane::assign(int size, Parity parity) {
+    this->size = size;
+
+    int words = (size + WORD_BITS - 1) / WORD_BITS;
+    grayBits.assign(words, 0);
+    purpleBits.assign(words, 0);
+    nonPurpleCount = size;
+    hash = 0;
+
+    for(int i = 0; i < size; i++) {
+        set(i, parity);
+    }
+}
+
+void ParityPlane::clear() {
+    size = 0;
+    grayBits.clear();
+    purpleBits.clear();
+    nonPurpleCount = 0;
+    hash = 0;
+}
+
+void ParityPlane::push(Parity parity) {
+    if(size % WORD_BITS == 0) {
+        grayBits.push_back(0);
+        purpleBits.push_back(0);
+    }
+
+    // new tile starts out neutral (non-purple)
+    size++;
+    nonPurpleCount++;
+    set(size - 1, parity);
+}
+
+void ParityPlane::setPurpleBits(const uint64_t * words) {
+    int purpleCount = 0;
+
+    for(unsigned int i = 0; i < purpleBits.size(); i++) {
+        uint64_t tiles = grayBits[i] | purpleBits[i];
+
+        // update the hash for the tiles which flip
+        for(uint64_t flipped = (purpleBits[i] ^ words[i]) & tiles; flipped; flipped &= flipped - 1) {
+            int index = i * WORD_BITS + __builtin_ctzll(flipped);
+            hash ^= zobristTileKey(index, PARITY_GRAY) ^ zobristTileKey(index, PARITY_PURPLE);
+        }
+
+        purpleBits[i] = words[i] & tiles;
+        grayBits[i] = tiles & ~words[i];
+        purpleCount += __builtin_popcountll(purpleBits[i]);
+    }
+
+    nonPurpleCount = size - purpleCount;
+}
+
+int ParityPlane::count(Parity parity) const {
+    int purpleCount = 0;
+    int grayCount = 0;
+
+    for(unsigned int i = 0; i < purpleBits.size(); i++) {
+        purpleCount += __builtin_popcountll(purpleBits[i]);
+        grayCount += __builtin_popcountll(grayBits[i]);
+    }
+
+    switch(parity) {
+        case PARITY_PURPLE: return purpleCount;
+        case PARITY_GRAY:   return grayCount;
+        default:            return size - purpleCount - grayCount;
+    }
+}
+
+int ParityPlane::getNonPurpleCount() const {
+    return nonPurpleCount;
+}
+
+bool ParityPlane::isAllPurple() const {
+    return nonPurpleCount == 0;
+}
+
+int ParityPlane::getSize() const {
+    return size;
+}
+
+int ParityPlane::getWordCount() const {
+    return purpleBits.size();
+}
+
+const std::vector<uint64_t> & ParityPlane::getGrayBits() const {
+    return grayBits;
+}
+
+const std::vector<uint64_t> & ParityPlane::getPurpleBits() const {
+    return purpleBits;
+}
+
+bool ParityPlane::operator==(const ParityPlane & other) const {
+    return size == other.size && grayBits == other.grayBits &&
+        purpleBits == other.purpleBits;
+}
+
+bool ParityPlane::operator!=(const ParityPlane & other) const {
+    return !(*this == other);
+}
@@ -0,0 +1,153 @@
+// Implementation for replays
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#include "level/level.hpp"
+#include "level/replay.hpp"
+
+Replay::Replay() {}
+
+Replay::Replay(const std::string & levelID) : levelID(levelID) {}
+
+void Replay::recordTick(uint8_t keys) {
+    tickCount++;
+
+    // extend the last run if the keys haven't changed (and it isn't full)
+    if(!keyRuns.empty() && keyRuns.back().keys == keys && keyRuns.back().ticks < UINT16_MAX) {
+        keyRuns.back().ticks++;
+    } else {
+        keyRuns.push_back({1, keys, 0});
+    }
+}
+
+void Replay::recordStep(SimInput input) {
+    steps.push_back(input);
+}
+
+void Replay::finish(uint64_t finalHash) {
+    this->finalHash = finalHash;
+}
+
+bool Replay::save(const std::string & path) const {
+    ReplayFileHeader header = {};
+    if(levelID.size() >= sizeof(header.levelID)) {
+        printf("Level ID %s too long for a replay\n", levelID.c_str());
+        return false;
+    }
+
+    memcpy(header.magic, REPLAY_FILE_MAGIC, sizeof(header.magic));
+    header.version = REPLAY_FILE_VERSION;
+    memcpy(header.levelID, levelID.c_str(), levelID.size());
+    header.tickCount = tickCount;
+    header.runCount = keyRuns.size();
+    header.stepCount = steps.size();
+    header.finalHash = finalHash;
+
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(keyRuns.data()),
+        keyRuns.size() * sizeof(ReplayKeyRun));
+    out.write(reinterpret_cast<const char *>(steps.data()), steps.size());
+
+    if(!out.good()) {
+        printf("Error writing replay %s\n", path.c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool Replay::load(const std::string & path) {
+    std::ifstream in(path, std::ios::binary);
+    ReplayFileHeader header;
+
+    if(!in.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        memcmp(header.magic, REPLAY_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != REPLAY_FILE_VERSION) {
+        printf("Error loading replay %s, not a (current) replay file\n", path.c_str());
+        return false;
+    }
+
+    // the counts must match the file's size before anything's sized from them
+    uint64_t expectedSize = sizeof(header) + uint64_t(header.runCount) * sizeof(ReplayKeyRun) +
+        header.stepCount;
+
+    in.seekg(0, std::ios::end);
+    uint64_t fileSize = in.tellg();
+    in.seekg(sizeof(header), std::ios::beg);
+
+    if(fileSize != expectedSize) {
+        printf("Error loading replay %s, file is truncated or corrupt\n", path.c_str());
+        return false;
+    }
+
+    header.levelID[sizeof(header.levelID) - 1] = '\0';
+    levelID = header.levelID;
+    tickCount = header.tickCount;
+    finalHash = header.finalHash;
+
+    keyRuns.resize(header.runCount);
+    steps.resize(header.stepCount);
+
+    if(!in.read(reinterpret_cast<char *>(keyRuns.data()), keyRuns.size() * sizeof(ReplayKeyRun)) ||
+        !in.read(reinterpret_cast<char *>(steps.data()), steps.size())) {
+        printf("Error loading replay %s, file is truncated\n", path.c_str());
+        return false;
+    }
+
+    playbackRun = 0;
+    playbackTicks = 0;
+
+    return true;
+}
+
+bool Replay::nextKeys(uint8_t & keys) {
+    // skip finished (or empty) runs
+    while(playbackRun < keyRuns.size() && playbackTicks >= keyRuns[playbackRun].ticks) {
+        playbackRun++;
+        playbackTicks = 0;
+    }
+
+    if(playbackRun >= keyRuns.size()) return false;
+
+    keys = keyRuns[playbackRun].keys;
+    playbackTicks++;
+    return true;
+}
+
+bool Replay::verify(Level & level) const {
+    for(uint8_t input: steps) {
+        level.step((SimInput)input);
+    }
+
+    return level.getHash() == finalHash;
+}
+
+int Replay::firstDifference(const Replay & other) const {
+    unsigned int length = std::min(steps.size(), other.steps.size());
+
+    for(unsigned int i = 0; i < length; i++) {
+        if(steps[i] != other.steps[i]) return i;
+    }
+
+    return steps.size() == other.steps.size() ? -1 : length;
+}
+
+const std::string & Replay::getLevelID() const {
+    return levelID;
+}
+
+const std::vector<uint8_t> & Replay::getSteps() const {
+    return steps;
+}
+
+uint32_t Replay::getTickCount() const {
+    return tickCount;
+}
+
+uint64_t Replay::getFinalHash() const {
+    return finalHash;
+}
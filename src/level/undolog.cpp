@@ -0,0 +1,80 @@
+// Implementation for the undo log
+
+#include "level/undolog.hpp"
+
+UndoLog::UndoLog(int capacity) : records(capacity) {}
+
+void UndoLog::clear() {
+    start = end = 0;
+    steps = 0;
+}
+
+void UndoLog::beginStep(uint64_t hash) {
+    push({UNDO_STEP, 0, -1, 0, hash});
+    steps++;
+}
+
+// the log always starts at a step, drop it and the records up to the next
+void UndoLog::dropStep() {
+    if(records[start % records.size()].type == UNDO_STEP) steps--;
+    start++;
+
+    while(start < end && records[start % records.size()].type != UNDO_STEP) {
+        start++;
+    }
+}
+
+void UndoLog::mergeStep() {
+    uint64_t step = end;
+    while(step > start && records[(step - 1) % records.size()].type != UNDO_STEP) step--;
+    if(step == start) return;
+
+    // with no move before it to fold into, a move that changed something
+    // stays a move of its own (so the log still starts at a step, and its
+    // changes can be undone)
+    if(step - 1 == start && step < end) return;
+
+    // shift the move's records over its step record (just dropping the step
+    // if there are none)
+    for(uint64_t i = step; i < end; i++) {
+        records[(i - 1) % records.size()] = records[i % records.size()];
+    }
+
+    end--;
+    steps--;
+}
+
+bool UndoLog::findStep(uint64_t hash, uint64_t & position) const {
+    for(uint64_t i = start; i < end; i++) {
+        const UndoRecord & record = records[i % records.size()];
+
+        if(record.type == UNDO_STEP && record.data == hash) {
+            position = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void UndoLog::truncate(uint64_t position) {
+    while(end > position) {
+        if(records[--end % records.size()].type == UNDO_STEP) steps--;
+    }
+}
+
+uint64_t UndoLog::getEnd() const {
+    return end;
+}
+
+int UndoLog::getStepCount() const {
+    return steps;
+}
+
+int UndoLog::getRecordCount() const {
+    return end - start;
+}
+
+int UndoLog::getCapacity() const {
+    return records.size();
+}
@@ -8,17 +8,79 @@
  * @copyright Copyright (c) 2020
  * 
  */
+#include <chrono>
+#include <cstring>
+
 #include "main.hpp"
 #include "memswap.hpp"
+#include "utils/renderstats.hpp"
+#include "utils/spritebatch.hpp"
+#include "utils/textureatlas.hpp"
 
+// usage: memswap [-startup-bench] [-render-stats] [-no-atlas] [-no-batch]
+//                [-record <dir>] [-replay <file>]
+//        -startup-bench reports the time from process start until the
+//        resources are loaded (the menu is ready), then exits
+//        -render-stats prints the draw calls/texture switches of a frame
+//        every RENDER_STATS_FRAMES frames
+//        -no-atlas uploads each texture on its own (to compare render stats)
+//        -no-batch draws each texture with its own draw call (likewise)
+//        -record saves a replay of each level played to <dir>/<level ID>.rpl
+//        -replay plays back a replay's level with its recorded input, reports
+//        whether it ends in the recorded state, then exits
 int main(int argc, char* args[]) {
+	auto startTime = std::chrono::steady_clock::now();
+	bool startupBench = false;
+	bool renderStats = false;
+	const char * recordDir = NULL;
+	const char * replayPath = NULL;
+
+	for(int i = 1; i < argc; i++) {
+		if(std::strcmp(args[i], STARTUP_BENCH_ARG) == 0) {
+			startupBench = true;
+		} else if(std::strcmp(args[i], RENDER_STATS_ARG) == 0) {
+			renderStats = true;
+		} else if(std::strcmp(args[i], NO_ATLAS_ARG) == 0) {
+			TextureAtlas::setEnabled(false);
+		} else if(std::strcmp(args[i], NO_BATCH_ARG) == 0) {
+			SpriteBatch::setEnabled(false);
+		} else if(std::strcmp(args[i], RECORD_ARG) == 0 && i + 1 < argc) {
+			recordDir = args[++i];
+		} else if(std::strcmp(args[i], REPLAY_ARG) == 0 && i + 1 < argc) {
+			replayPath = args[++i];
+		}
+	}
+
 	MemSwap memSwap;
 
+	if(recordDir) {
+		memSwap.setRecordDir(recordDir);
+	}
+
+	if(replayPath && !memSwap.startPlayback(replayPath)) {
+		memSwap.quit();
+		return 1;
+	}
+	int frames = 0;
+
 	// Game Loop
 	while(memSwap.isPlaying()) {
 		memSwap.handleEvents();
 		memSwap.update();
 		memSwap.render();		
+		frames++;
+
+		if(renderStats && frames % RENDER_STATS_FRAMES == 0) {
+			printf("draw calls: %d, texture switches: %d\n", RenderStats::getDrawCalls(),
+				RenderStats::getTextureSwitches());
+		}
+
+		if(startupBench && !memSwap.getResManager().loadingResources()) {
+			double ms = std::chrono::duration<double, std::milli>(
+				std::chrono::steady_clock::now() - startTime).count();
+			printf("menu ready after %.1f ms (%d frames)\n", ms, frames);
+			break;
+		}
 	}
 
 	memSwap.quit();
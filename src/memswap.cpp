@@ -9,12 +9,18 @@
  * 
  */
 
+#include <algorithm>
+
  #include "memswap.hpp"
  
 #include "gameStates/splashstate.hpp"
 #include "gameStates/menustate.hpp"
 #include "gameStates/playstate.hpp"
 #include "gameStates/pausestate.hpp"
+#include "utils/allocstats.hpp"
+#include "utils/profiler.hpp"
+#include "utils/renderstats.hpp"
+#include "utils/spritebatch.hpp"
 
 MemSwap::MemSwap() : currTime(SDL_GetPerformanceCounter()), gameStates(), 
     resourceManager(RES_PATHS_FILE, init()), playerProfile() {
@@ -122,27 +128,67 @@ bool MemSwap::loadProfile() {
 
 /// Handle game events
 void MemSwap::handleEvents() {
-    if(nextState != GAME_STATE_EXIT && !minimized && !gameStates.empty()) {
+    PROFILE_ZONE("MemSwap::handleEvents");
+
+    if(nextState != GAME_STATE_EXIT && !gameStates.empty()) {
         bool playComplete = currState == GAME_STATE_PLAY &&
             dynamic_cast<PlayState *>(gameStates.at(GAME_STATE_PLAY).get())->levelIsComplete();
 
-        // normal polled events
-        while(SDL_PollEvent(&e)) {
+        // with nothing to render, sleep until there's input (or the timeout)
+        int waitMS = 0;
+        if(minimized) {
+            waitMS = IDLE_WAIT_MS;
+        } else if(!renderFrame) {
+            waitMS = keyHeld() ? FRAME_WAIT_MS : IDLE_WAIT_MS;
+        }
+
+        bool idleWait = waitMS == IDLE_WAIT_MS;
+        bool woken = false;
+
+        // normal polled events (the first waited on)
+        while(waitMS > 0 ? SDL_WaitEventTimeout(&e, waitMS) : SDL_PollEvent(&e)) {
+            waitMS = 0;
+            woken = true;
+            redraw = true;
+
             handleWindowEvents();
             
-            // no polled events for play state, unless in postgame state
-            if(currState != GAME_STATE_PLAY || playComplete) {
-                gameStates.at(currState)->handleEvents(this, e);
+            // no polled events for play state, unless in postgame state (and
+            // none while fading between states/levels). Its keys are read
+            // each tick, so only presses are noted here
+            if(!minimized && !screenFade.isFading()) {
+                if(currState != GAME_STATE_PLAY || playComplete) {
+                    gameStates.at(currState)->handleEvents(this, e);
+                } else {
+                    dynamic_cast<PlayState *>(gameStates.at(GAME_STATE_PLAY).get())->keyPressed(e);
+                }
             }
         }
 
-        // keyState events for play state if not completed
-        if(currState == GAME_STATE_PLAY && !playComplete) {
-            gameStates.at(currState)->handleEvents(this, e);
+        // time spent idle isn't passed on to the states (nothing was
+        // changing), so movement etc. starts from where it was. Input that
+        // woke the loop gets a tick right away rather than after the next
+        // TICK_MS. (Waits while a key is held are frame pacing, so count.)
+        if(idleWait) {
+            currTime = SDL_GetPerformanceCounter();
+            lastPresentTime = 0;
+            if(woken) accumulator = std::max(accumulator, TICK_MS);
         }
+
     }   
 }
 
+bool MemSwap::keyHeld() const {
+    int numKeys = 0;
+    const Uint8 * keyStates = SDL_GetKeyboardState(&numKeys);
+
+    for(int i = 0; i < numKeys; i++) {
+        if(keyStates[i]) return true;
+    }
+
+    return false;
+}
+
 void MemSwap::handleWindowEvents() {
     if(e.type == SDL_QUIT) {
         setNextState(GAME_STATE_EXIT);
@@ -164,6 +210,23 @@ void MemSwap::handleWindowEvents() {
         }
     }
 
+    if(e.type == SDL_RENDER_TARGETS_RESET || e.type == SDL_RENDER_DEVICE_RESET) {
+        renderResets++;
+    }
+
+#ifdef PROFILING
+    // F9 writes the last PROFILE_DUMP_SECONDS of profiling zones
+    if(e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F9 && !e.key.repeat) {
+        Profiler::dump(PROFILE_PATH, PROFILE_DUMP_SECONDS);
+    }
+#endif
+
+    // F3 toggles the performance overlay
+    if(e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F3 && !e.key.repeat) {
+        perfOverlay.toggle();
+        redraw = true;
+    }
+
     // If user presses F11, toggle fullscreen
     if(e.type == SDL_KEYDOWN && e.key.keysym.sym == SDLK_F11) {
         if(fullscreen) {
@@ -179,49 +242,156 @@ void MemSwap::handleWindowEvents() {
 
 /// Update the current game state
 void MemSwap::update() {
+    PROFILE_ZONE("MemSwap::update");
+
     // update delta
     lastTime = currTime;
     currTime = SDL_GetPerformanceCounter();
     delta = (float) ((currTime - lastTime) * 1000 / (float) SDL_GetPerformanceFrequency());
 
-    if(!gameStates.empty()) {
-        gameStates.at(currState)->update(this, delta);
+    // enter the first state right away (there's nothing to render before it)
+    if(currState == GAME_STATE_NULL) {
+        changeState();
+    }
+
+    accumulator += std::min(delta, MAX_FRAME_MS);
+
+    while(accumulator >= TICK_MS && playing) {
+        tick();
+        accumulator -= TICK_MS;
+    }
+
+    tickAlpha = accumulator / TICK_MS;
+
+    // render if anything changed, including on the update the state went
+    // idle (its last change)
+    bool idle = !gameStates.empty() && gameStates.at(currState)->isIdle() &&
+        !screenFade.isFading();
+    renderFrame = redraw || !idle || !stateIdle;
+
+    stateIdle = idle;
+    redraw = false;
+
+    if(perfOverlay.isShown()) {
+        auto playState = currState == GAME_STATE_PLAY ?
+            dynamic_cast<PlayState *>(gameStates.at(GAME_STATE_PLAY).get()) : nullptr;
+        int entities = playState ? playState->getEntityCount() : 0;
+        double hintMs = playState ? playState->getHintLatency() : -1.0;
+        auto font = resourceManager.hasFont(OVERLAY_FONT_ID) ?
+            resourceManager.getFont(OVERLAY_FONT_ID) : nullptr;
+
+        perfOverlay.update(font, screenWidth, RenderStats::getDrawCalls(),
+            RenderStats::getTextureSwitches(), entities, hintMs);
     }
-        
-    changeState();
 }
 
 /// Render the current game state, if not minimized
-void MemSwap::render() const {
-    if(!minimized) {
+void MemSwap::render() {
+    PROFILE_ZONE("MemSwap::render");
+
+    if(!minimized && renderFrame) {
         // Clear renderer
         SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF);
         SDL_RenderClear(renderer);
         
-        // Render stuff for current game state
+        // Render stuff for current game state (textures batched, see SpriteBatch)
+        SpriteBatch::begin(renderer);
         gameStates.at(currState)->render(renderer);
+        SpriteBatch::end();
+
+        screenFade.render(renderer, screenWidth, screenHeight);
+
+        // the frame's counts, without the overlay's own draws
+        RenderStats::endFrame();
+        perfOverlay.render(renderer);
+        RenderStats::discardFrame();
         
         // render to screen
         SDL_RenderPresent(renderer);
+
+        // frame times are from one present to the next (passes that skip
+        // rendering aren't frames, and the first after idling has no last)
+        Uint64 presentTime = SDL_GetPerformanceCounter();
+        if(lastPresentTime != 0) {
+            perfOverlay.recordFrame((float) ((presentTime - lastPresentTime) * 1000 /
+                (float) SDL_GetPerformanceFrequency()), AllocStats::getAllocations());
+        }
+        lastPresentTime = presentTime;
     }    
 }
 
-void MemSwap::playSound(std::string soundID) const {
+void MemSwap::setRecordDir(const std::string & dir) {
+    recordDir = dir;
+}
+
+std::string MemSwap::getRecordDir() const {
+    return recordDir;
+}
+
+bool MemSwap::startPlayback(const std::string & path) {
+    auto replay = std::make_shared<Replay>();
+    if(!replay->load(path)) return false;
+
+    if((unsigned int) indexOfLevelID(replay->getLevelID()) >= LVLS_LABELS.size()) {
+        printf("Replay %s is of an unknown level (%s)\n", path.c_str(),
+            replay->getLevelID().c_str());
+        return false;
+    }
+
+    playback = replay;
+    currLevelID = replay->getLevelID();
+    return true;
+}
+
+std::shared_ptr<Replay> MemSwap::getPlayback() const {
+    return playback;
+}
+
+void MemSwap::startFade(std::function<void()> onFaded) {
+    screenFade.start(onFaded);
+}
+
+bool MemSwap::isFading() const {
+    return screenFade.isFading();
+}
+
+void MemSwap::playSound(ResId soundID) const {
     resourceManager.getSound(soundID)->play();
 }
 
+void MemSwap::playSound(SoundHandle sound) const {
+    resourceManager.getSound(sound)->play();
+}
+
 /// Set next state to change to indicated by the given state ID
 void MemSwap::setNextState(GameStateID stateID) {
     nextState = stateID;
 }
 
-/// Change states if needed
+/// Change states if needed, fading out of the current one first
 void MemSwap::changeState() {
+    PROFILE_ZONE("MemSwap::changeState");
+
+    if(nextState != currState && !screenFade.isFading()) {
+        if(currState == GAME_STATE_NULL) {
+            switchState();
+            screenFade.fadeIn();
+        } else {
+            screenFade.start([this]() {
+                switchState();
+            });
+        }
+    }
+}
+
+/// Switch to the next state (once the screen is black)
+void MemSwap::switchState() {
+    PROFILE_ZONE("MemSwap::switchState");
+
     if(nextState != currState) {
-        // exit current state/cleanup + fade out
+        // exit current state/cleanup
         if(currState != GAME_STATE_NULL && currState != GAME_STATE_EXIT) {
             gameStates.at(currState)->exitState();
-            gameStates.at(currState)->fade(renderer, this, false); 
         }
 
         // If next state set to exit/null, stop playing
@@ -271,9 +441,10 @@ void MemSwap::changeState() {
             removeGameState(currState);
         }
 
-        // enter new state + fadein        
+        redraw = true;
+
+        // enter new state (faded in by changeState)
         gameStates.at(nextState)->enterState(this);
-        gameStates.at(nextState)->fade(renderer, this, true);
         currState = nextState;
     }
 }
@@ -293,6 +464,27 @@ void MemSwap::removeGameState(GameStateID gameStateID) {
     }
 }
 
+// advance the current state (and any fade) by one fixed tick
+void MemSwap::tick() {
+    PROFILE_ZONE("MemSwap::tick");
+
+    if(!gameStates.empty()) {
+        bool playComplete = currState == GAME_STATE_PLAY &&
+            dynamic_cast<PlayState *>(gameStates.at(GAME_STATE_PLAY).get())->levelIsComplete();
+
+        // keyState events for play state if not completed (read each tick)
+        if(nextState != GAME_STATE_EXIT && !minimized && !screenFade.isFading() &&
+            currState == GAME_STATE_PLAY && !playComplete) {
+            gameStates.at(currState)->handleEvents(this, e);
+        }
+
+        gameStates.at(currState)->update(this, TICK_MS);
+    }
+
+    changeState();
+    screenFade.update(TICK_MS);
+}
+
 // update player profile data
 void MemSwap::updatePlayTime() {
     // update playtime
@@ -325,6 +517,11 @@ void MemSwap::updatePlayerStats(int resets, int flipped, int movesUndone,
 }
 
 void MemSwap::quit() {
+    // save any level being recorded
+    if(gameStates.count(GAME_STATE_PLAY)) {
+        dynamic_cast<PlayState *>(gameStates.at(GAME_STATE_PLAY).get())->finishRecording();
+    }
+
     // if exiting on play state, update time/player stats
     if(currState == GAME_STATE_PLAY) {
         updatePlayTime();
@@ -334,6 +531,7 @@ void MemSwap::quit() {
 
     // save player data on exit
     saveProfile();
+    perfOverlay.saveHistogram(FRAME_TIMES_PATH);
 
     // sdl cleanup
     Mix_HaltMusic();
@@ -371,6 +569,14 @@ SDL_Renderer * MemSwap::getRenderer() const {
     return renderer;
 }
 
+float MemSwap::getTickAlpha() const {
+    return tickAlpha;
+}
+
+int MemSwap::getRenderResets() const {
+    return renderResets;
+}
+
 int MemSwap::getScreenWidth() const {
     return screenWidth;
 }
@@ -415,6 +621,13 @@ bool MemSwap::advanceLevel() {
     return false;
 }
 
+// ID of the level after the current one ("" if it's the last)
+std::string MemSwap::getNextLevelID() const {
+    auto currIndex = (unsigned int) indexOfLevelID(currLevelID);
+
+    return currIndex < LVLS_LABELS.size() - 1 ? LVLS_LABELS.at(currIndex + 1) : "";
+}
+
 void MemSwap::setCurrLevelID(std::string levelID) {
     currLevelID = levelID;
 }
@@ -423,8 +636,12 @@ void MemSwap::setCurrMenuScreen(int screenID) {
     currMenuScreen = screenID;
 }
 
-void MemSwap::loadNextResource () {
-    resourceManager.loadNextResource();
+void MemSwap::startLoadingResources() {
+    resourceManager.startLoading();
+}
+
+void MemSwap::uploadLoadedResources() {
+    resourceManager.uploadLoadedResources();
 }
 
 const ResManager & MemSwap::getResManager() {
@@ -0,0 +1,106 @@
+// Implementation for the background hint solver
+
+#include <algorithm>
+
+#include "solver/hintengine.hpp"
+
+HintEngine::HintEngine(size_t systemMemory) : cancelling(false),
+    memoryCap(std::clamp(systemMemory / 4, MIN_MEMORY_CAP, MAX_MEMORY_CAP)) {
+
+    thread = std::thread(&HintEngine::run, this);
+}
+
+HintEngine::~HintEngine() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quitting = true;
+        cancelling = true;
+    }
+    wake.notify_one();
+
+    if(thread.joinable()) thread.join();
+}
+
+void HintEngine::request(const Level & level) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        requested = true;
+        requestPath = level.getMapPath();
+        level.saveState(requestState);
+        requestHash = level.getHash();
+        requestTime = std::chrono::steady_clock::now();
+
+        hintReady = false;
+        cancelling = true;
+    }
+    wake.notify_one();
+}
+
+void HintEngine::cancel() {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    requested = false;
+    hintReady = false;
+    cancelling = true;
+}
+
+bool HintEngine::poll(Hint & hint) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if(!hintReady) return false;
+
+    hint = this->hint;
+    hintReady = false;
+    return true;
+}
+
+bool HintEngine::isSearching() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return requested || searching;
+}
+
+// wait for requests and search them, one at a time
+void HintEngine::run() {
+    // leave a core for the game itself
+    int threads = std::max((int)std::thread::hardware_concurrency() - 1, 1);
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while(true) {
+        wake.wait(lock, [this] { return requested || quitting; });
+        if(quitting) return;
+
+        std::string path = requestPath;
+        MapState start = requestState;
+        Hint result;
+        result.stateHash = requestHash;
+        auto startTime = requestTime;
+
+        requested = false;
+        searching = true;
+        cancelling = false;
+        lock.unlock();
+
+        if(!solver || solverPath != path) {
+            solver = std::make_unique<Solver>(path, memoryCap);
+            solverPath = path;
+        }
+
+        SolverResult solved = solver->solve(start, threads, &cancelling);
+
+        lock.lock();
+        searching = false;
+
+        // drop the result if the player has since moved on
+        if(solved.cancelled || cancelling || requested) continue;
+
+        if(!solved.moves.empty()) result.move = solved.moves.front();
+        result.unsolvable = !solved.solved && solved.exhausted;
+        result.capped = !solved.solved && !solved.exhausted;
+        result.latency = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - startTime).count();
+
+        hint = result;
+        hintReady = true;
+    }
+}
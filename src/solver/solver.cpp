@@ -0,0 +1,756 @@
+// Implementation for the level solver
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "solver/solver.hpp"
+#include "entities/boost.hpp"
+#include "entities/player.hpp"
+#include "entities/portal.hpp"
+#include "entities/receptor.hpp"
+
+// flags for cells during dead state checks
+const uint8_t CELL_EXEMPT = 1;      // holds a receptor/portal/movable
+const uint8_t CELL_PORTAL = 2;
+const uint8_t CELL_VISITED = 4;
+const uint8_t CELL_MOVABLE = 8;
+const uint8_t CELL_RECEPTOR = 16;
+
+// bytes needed to store values up to maxValue
+int bytesFor(uint32_t maxValue) {
+    int bytes = 1;
+    while(bytes < 4 && maxValue >> (8 * bytes)) bytes++;
+    return bytes;
+}
+
+// store/load an unsigned value in the given number of bytes (little endian)
+void packValue(uint8_t * dest, uint32_t value, int bytes) {
+    for(int i = 0; i < bytes; i++) dest[i] = value >> (8 * i);
+}
+
+uint32_t unpackValue(const uint8_t * src, int bytes) {
+    uint32_t value = 0;
+    for(int i = 0; i < bytes; i++) value |= uint32_t(src[i]) << (8 * i);
+    return value;
+}
+
+SolverWorker::SolverWorker(std::string tiledMapPath) : level(tiledMapPath) {
+    level.saveState(initialState);
+    scratchState = initialState;
+
+    int cells = level.getGridWidth() * level.getGridHeight();
+    scratchWords.resize(initialState.tileParities.getWordCount());
+    cellFlags.resize(cells);
+    cellQueue.resize(cells);
+    cutCells.resize(cells);
+    cutOrder.resize(cells);
+}
+
+Solver::Solver(std::string tiledMapPath, size_t memoryCap) :
+    tiledMapPath(tiledMapPath), pending(0), goalNode(NO_NODE), stopping(false),
+    capped(false), cancelled(false), memoryCap(memoryCap) {
+
+    workers.push_back(std::make_unique<SolverWorker>(tiledMapPath));
+
+    const Map & map = workers[0]->level.getMap();
+    width = map.getWidth();
+    height = map.getHeight();
+
+    initLayout();
+    initFreeTiles();
+
+    workers[0]->state.resize(stateSize);
+    workers[0]->childState.resize(stateSize);
+}
+
+// determine which entities need which parts of the compact state
+void Solver::initLayout() {
+    auto & entities = workers[0]->level.getMap().getEntities();
+
+    monotone = true;
+
+    for(auto & entity: entities) {
+        switch(entity->getKind()) {
+            case ENTITY_PLAYER:
+            case ENTITY_DIAMOND:
+                movableIDs.push_back(entity->getEntityID());
+                monotone = monotone && entity->getParity() == PARITY_PURPLE;
+                break;
+            case ENTITY_PORTAL:
+                portalIDs.push_back(entity->getEntityID());
+                monotone = monotone && entity->getParity() == PARITY_PURPLE;
+                break;
+            case ENTITY_RECEPTOR:
+                receptorIDs.push_back(entity->getEntityID());
+                break;
+            default:
+                break;
+        }
+    }
+
+    planeWords = workers[0]->initialState.tileParities.getWordCount();
+
+    // links are stored + 1, so no link (-1) is 0
+    cellBytes = bytesFor(std::max(width * height - 1, 0));
+    linkBytes = bytesFor(entities.size());
+
+    flagsOffset = planeWords * sizeof(uint64_t);
+    positionsOffset = flagsOffset + (entities.size() + 3) / 4;
+    linkOffset = positionsOffset + movableIDs.size() * cellBytes;
+    portalsOffset = linkOffset + linkBytes;
+    stateSize = portalsOffset + 1;
+}
+
+// mark tiles that can flip in the same move as another tile: boost runs,
+// receptors (flip on merging), portals (flip on vanishing) and the tiles a
+// diamond can be knocked off of next to a bumped boost
+void Solver::initFreeTiles() {
+    const Map & map = workers[0]->level.getMap();
+    freeTiles.assign(planeWords, 0);
+
+    auto markTile = [&](int x, int y) {
+        if(map.inBounds(x, y)) {
+            int idx = map.xyToIndex(x, y);
+            freeTiles[idx / 64] |= uint64_t(1) << (idx % 64);
+        }
+    };
+
+    for(auto & entity: map.getEntities()) {
+        markTile(entity->getGridX(), entity->getGridY());
+
+        // tiles slid over by a boosted entity, plus the one past the end that
+        // a diamond pushed ahead of a boosted player leaves
+        if(entity->getKind() == ENTITY_BOOST) {
+            auto boost = static_cast<Boost *>(entity.get());
+            auto coords = boost->getCoords(boost->getDirection());
+            int dx = coords.first - boost->getGridX();
+            int dy = coords.second - boost->getGridY();
+
+            for(int i = 1; i <= boost->getPower(); i++) {
+                markTile(boost->getGridX() + dx * i, boost->getGridY() + dy * i);
+            }
+
+            // boosts on purple tiles are bumped by entities next to them
+            if(map.getTileParity(boost->getGridX(), boost->getGridY()) == PARITY_PURPLE) {
+                for(Direction side: {DIR_UP, DIR_DOWN, DIR_LEFT, DIR_RIGHT}) {
+                    auto sideCoords = boost->getCoords(side);
+                    markTile(sideCoords.first + dx, sideCoords.second + dy);
+                }
+            }
+        }
+    }
+}
+
+void Solver::encode(const SolverWorker & worker, uint8_t * state) const {
+    const Map & map = worker.level.getMap();
+    auto & entities = map.getEntities();
+
+    std::memset(state, 0, stateSize);
+    std::memcpy(state, map.getTileParities().getPurpleBits().data(),
+        planeWords * sizeof(uint64_t));
+
+    for(unsigned int i = 0; i < entities.size(); i++) {
+        auto & entity = entities[i];
+        bool inGrid = map.getGridEntityID(entity->getGridX(), entity->getGridY()) == (int)i;
+        uint8_t flags = entity->isVanished() | (inGrid << 1);
+
+        state[flagsOffset + i / 4] |= flags << (2 * (i % 4));
+    }
+
+    for(unsigned int i = 0; i < movableIDs.size(); i++) {
+        auto & movable = entities[movableIDs[i]];
+        packValue(state + positionsOffset + i * cellBytes,
+            map.xyToIndex(movable->getGridX(), movable->getGridY()), cellBytes);
+    }
+
+    int link = -1;
+    Player * player = map.getPlayer();
+    if(player && player->getLastPortal()) {
+        link = player->getLastPortal()->getEntityID();
+    }
+    packValue(state + linkOffset, link + 1, linkBytes);
+
+    state[portalsOffset] = map.arePortalsRemoved();
+}
+
+// fill the worker's scratch state from a compact state
+void Solver::decode(SolverWorker & worker, const uint8_t * state) const {
+    auto & entities = worker.level.getMap().getEntities();
+    MapState & scratchState = worker.scratchState;
+
+    scratchState = worker.initialState;
+
+    std::memcpy(worker.scratchWords.data(), state, planeWords * sizeof(uint64_t));
+    scratchState.tileParities.setPurpleBits(worker.scratchWords.data());
+
+    for(unsigned int i = 0; i < entities.size(); i++) {
+        EntityState & entityState = scratchState.entityStates[i];
+        uint8_t flags = state[flagsOffset + i / 4] >> (2 * (i % 4));
+
+        entityState.vanished = flags & 1;
+        entityState.inGrid = flags & 2;
+    }
+
+    for(unsigned int i = 0; i < movableIDs.size(); i++) {
+        int idx = unpackValue(state + positionsOffset + i * cellBytes, cellBytes);
+
+        EntityState & entityState = scratchState.entityStates[movableIDs[i]];
+        entityState.gridX = idx % width;
+        entityState.gridY = idx / width;
+
+        if(entities[movableIDs[i]]->getKind() == ENTITY_PLAYER) {
+            entityState.link = (int)unpackValue(state + linkOffset, linkBytes) - 1;
+        }
+    }
+
+    scratchState.portalsRemoved = state[portalsOffset];
+}
+
+// each move flips at most one tile outside of the free tiles (the first
+// step's origin, or that of a pushed diamond)
+int Solver::heuristic(const SolverWorker & worker) const {
+    if(!monotone) return 0;
+
+    auto & grayBits = worker.level.getMap().getTileParities().getGrayBits();
+    int h = 0;
+
+    for(int i = 0; i < planeWords; i++) {
+        h += __builtin_popcountll(grayBits[i] & ~freeTiles[i]);
+    }
+
+    return h;
+}
+
+// gray tiles only flip once an entity leaves (or merges onto) them, and
+// entities only move onto gray tiles. So every gray tile has to stay
+// connected to a movable, and a gray tile with at most one neighbour to
+// enter it from or leave it to (a gray tile, or a movable which may still be
+// standing on purple) can only be entered and never left.
+bool Solver::isDeadState(SolverWorker & worker) const {
+    if(!monotone) return false;
+
+    const Map & map = worker.level.getMap();
+    auto & entities = map.getEntities();
+    std::vector<uint8_t> & cellFlags = worker.cellFlags;
+    std::vector<int> & cellQueue = worker.cellQueue;
+
+    std::fill(cellFlags.begin(), cellFlags.end(), 0);
+
+    auto markEntity = [&](int entityID, uint8_t flags) {
+        auto & entity = entities[entityID];
+        if(!entity->isVanished()) {
+            cellFlags[map.xyToIndex(entity->getGridX(), entity->getGridY())] |= flags;
+        }
+    };
+
+    for(int entityID: receptorIDs) markEntity(entityID, CELL_EXEMPT | CELL_RECEPTOR);
+    for(int entityID: movableIDs) markEntity(entityID, CELL_EXEMPT | CELL_MOVABLE);
+    for(int entityID: portalIDs) markEntity(entityID, CELL_EXEMPT | CELL_PORTAL);
+
+    const int offsets[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+    int grayCount = 0;
+
+    // dead ends (a portal tile doesn't flip when left, so counts twice)
+    for(int y = 0; y < height; y++) {
+        for(int x = 0; x < width; x++) {
+            if(map.getTileParity(x, y) != PARITY_GRAY) continue;
+
+            uint8_t flags = cellFlags[map.xyToIndex(x, y)];
+            if(!(flags & CELL_PORTAL)) grayCount++;
+            if(flags & CELL_EXEMPT) continue;
+
+            int degree = 0;
+            for(auto & offset: offsets) {
+                int nx = x + offset[0];
+                int ny = y + offset[1];
+
+                if(map.getTileParity(nx, ny) == PARITY_GRAY) {
+                    degree += cellFlags[map.xyToIndex(nx, ny)] & CELL_PORTAL ? 2 : 1;
+                } else if(map.getTileParity(nx, ny) == PARITY_PURPLE &&
+                    cellFlags[map.xyToIndex(nx, ny)] & CELL_MOVABLE) {
+                    degree++;
+                }
+            }
+
+            if(degree <= 1) return true;
+        }
+    }
+
+    // diamonds with no side left to be pushed from onto a tile they can
+    // enter (or an entity, eg. a receptor) keep their tile gray
+    for(int entityID: movableIDs) {
+        auto & diamond = entities[entityID];
+        if(diamond->getKind() != ENTITY_DIAMOND || diamond->isVanished()) continue;
+
+        int x = diamond->getGridX();
+        int y = diamond->getGridY();
+        if(map.getTileParity(x, y) != PARITY_GRAY) continue;
+        bool pushable = false;
+
+        for(auto & offset: offsets) {
+            int fromX = x - offset[0];
+            int fromY = y - offset[1];
+            int toX = x + offset[0];
+            int toY = y + offset[1];
+
+            bool reachable = map.getTileParity(fromX, fromY) == PARITY_GRAY ||
+                map.getGridElement<Player>(fromX, fromY) != nullptr;
+            bool open = map.getTileParity(toX, toY) == PARITY_GRAY ||
+                map.getGridEntityID(toX, toY) != Map::NO_ENTITY;
+
+            if(reachable && open) {
+                pushable = true;
+                break;
+            }
+        }
+
+        if(!pushable) return true;
+    }
+
+    // connectivity of the gray tiles from the movables (through portals)
+    int queueStart = 0, queueEnd = 0;
+    int reached = 0;
+
+    auto visit = [&](int idx) {
+        if(!(cellFlags[idx] & CELL_VISITED)) {
+            cellFlags[idx] |= CELL_VISITED;
+            cellQueue[queueEnd++] = idx;
+        }
+    };
+
+    for(int entityID: movableIDs) {
+        auto & movable = entities[entityID];
+        if(!movable->isVanished()) {
+            visit(map.xyToIndex(movable->getGridX(), movable->getGridY()));
+        }
+    }
+
+    while(queueStart < queueEnd) {
+        int idx = cellQueue[queueStart++];
+        auto coords = map.indexToXY(idx);
+
+        if(map.getTileParity(coords.first, coords.second) == PARITY_GRAY &&
+            !(cellFlags[idx] & CELL_PORTAL)) {
+            reached++;
+        }
+
+        for(auto & offset: offsets) {
+            int nx = coords.first + offset[0];
+            int ny = coords.second + offset[1];
+
+            if(map.getTileParity(nx, ny) == PARITY_GRAY) visit(map.xyToIndex(nx, ny));
+        }
+
+        if(cellFlags[idx] & CELL_PORTAL) {
+            for(int entityID: portalIDs) {
+                auto portal = static_cast<Portal *>(entities[entityID].get());
+                Portal * other = portal->getOtherPortal();
+
+                if(map.xyToIndex(portal->getGridX(), portal->getGridY()) == idx &&
+                    other && !other->isVanished()) {
+                    visit(map.xyToIndex(other->getGridX(), other->getGridY()));
+                }
+            }
+        }
+    }
+
+    return reached < grayCount || isSplit(worker);
+}
+
+// an entity leaving a (non portal) cell flips it, so at most one movable
+// ever passes through it, and none through a receptor (merging ends the
+// move). If removing the cell cuts the gray tiles into parts, a part with
+// tiles to cover but no movable needs that one movable to enter it and end
+// there (on a receptor), and a part with movables to merge but no receptor
+// needs it to leave. Cut cells are found with Tarjan's DFS over the gray
+// tiles and the movables, keeping counts per subtree.
+bool Solver::isSplit(SolverWorker & worker) const {
+    const Map & map = worker.level.getMap();
+    auto & entities = map.getEntities();
+    std::vector<uint8_t> & cellFlags = worker.cellFlags;
+    std::vector<int> & stack = worker.cellQueue;
+    std::vector<SolverCutCell> & cells = worker.cutCells;
+    std::vector<int> & order = worker.cutOrder;
+
+    const int offsets[4][2] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+    int cellCount = width * height;
+
+    auto isGray = [&](int idx) {
+        auto coords = map.indexToXY(idx);
+        return map.getTileParity(coords.first, coords.second) == PARITY_GRAY;
+    };
+
+    auto isNode = [&](int idx) {
+        return isGray(idx) || cellFlags[idx] & CELL_MOVABLE;
+    };
+
+    // the cell's neighbours 0-3 are adjacent cells, 4 is the other portal
+    auto neighbour = [&](int idx, int i) {
+        auto coords = map.indexToXY(idx);
+
+        if(i < 4) {
+            int nx = coords.first + offsets[i][0];
+            int ny = coords.second + offsets[i][1];
+
+            if(!map.inBounds(nx, ny)) return -1;
+            int n = map.xyToIndex(nx, ny);
+            return isNode(n) ? n : -1;
+        }
+
+        if(!(cellFlags[idx] & CELL_PORTAL)) return -1;
+
+        for(int entityID: portalIDs) {
+            auto portal = static_cast<Portal *>(entities[entityID].get());
+            Portal * other = portal->getOtherPortal();
+
+            if(map.xyToIndex(portal->getGridX(), portal->getGridY()) == idx &&
+                other && !other->isVanished()) {
+                return map.xyToIndex(other->getGridX(), other->getGridY());
+            }
+        }
+
+        return -1;
+    };
+
+    auto ownCounts = [&](int idx) {
+        SolverCutCounts counts;
+        uint8_t flags = cellFlags[idx];
+
+        if(flags & CELL_MOVABLE) {
+            counts.movables = 1;
+            counts.leaving = isGray(idx) ? 1 : 0;
+        }
+        counts.receptors = flags & CELL_RECEPTOR ? 1 : 0;
+        counts.cover = flags & CELL_EXEMPT ? 0 : 1;
+
+        return counts;
+    };
+
+    // tally a part cut off by removing a cell
+    auto addPart = [](SolverCutCell & cell, const SolverCutCounts & part) {
+        if(part.cover > 0 && part.movables == 0) {
+            cell.stranded++;
+            if(part.receptors == 0) cell.strandedNoReceptor++;
+        }
+        if(part.receptors == 0) cell.exits += part.leaving;
+    };
+
+    int orderEnd = 0;
+    int stackEnd = 0;
+
+    auto enter = [&](int idx, int parent) {
+        SolverCutCell & cell = cells[idx];
+        cell.order = cell.low = orderEnd;
+        cell.parent = parent;
+        cell.next = 0;
+        cell.parentSkipped = false;
+        cell.subtree = ownCounts(idx);
+        cell.cut = SolverCutCounts();
+        cell.stranded = cell.strandedNoReceptor = cell.exits = 0;
+
+        order[orderEnd++] = idx;
+        stack[stackEnd++] = idx;
+    };
+
+    for(int idx = 0; idx < cellCount; idx++) cells[idx].order = -1;
+
+    for(int start = 0; start < cellCount; start++) {
+        if(cells[start].order >= 0 || !isNode(start)) continue;
+
+        int componentStart = orderEnd;
+        enter(start, -1);
+
+        while(stackEnd > 0) {
+            int idx = stack[stackEnd - 1];
+            SolverCutCell & cell = cells[idx];
+
+            if(cell.next < 5) {
+                int n = neighbour(idx, cell.next++);
+                if(n < 0) continue;
+
+                // skip the tree edge back to the parent only once, as a
+                // portal pair may also be adjacent
+                if(n == cell.parent && !cell.parentSkipped) {
+                    cell.parentSkipped = true;
+                } else if(cells[n].order >= 0) {
+                    cell.low = std::min(cell.low, cells[n].order);
+                } else {
+                    enter(n, idx);
+                }
+                continue;
+            }
+
+            stackEnd--;
+            if(cell.parent < 0) continue;
+
+            SolverCutCell & parent = cells[cell.parent];
+            parent.low = std::min(parent.low, cell.low);
+            parent.subtree.add(cell.subtree);
+
+            // the subtree is cut off without the parent
+            if(cell.low >= parent.order) {
+                parent.cut.add(cell.subtree);
+                addPart(parent, cell.subtree);
+            }
+        }
+
+        // movables to merge with no receptor to reach at all
+        const SolverCutCounts & total = cells[start].subtree;
+        if(total.leaving > 0 && total.receptors == 0) return true;
+
+        for(int i = componentStart; i < orderEnd; i++) {
+            int idx = order[i];
+            SolverCutCell & cell = cells[idx];
+            uint8_t flags = cellFlags[idx];
+            if(flags & CELL_PORTAL) continue;
+
+            // the rest of the component, outside the cut off subtrees
+            if(idx != start) {
+                SolverCutCounts rest = total;
+                rest.add(ownCounts(idx), -1);
+                rest.add(cell.cut, -1);
+                addPart(cell, rest);
+            }
+
+            if(flags & CELL_RECEPTOR) {
+                if(cell.stranded > 0 || cell.exits > 1) return true;
+            } else if(flags & CELL_MOVABLE) {
+                if(cell.stranded > 1 || cell.strandedNoReceptor > 0 || cell.exits > 0) return true;
+            } else if(cell.stranded > 1 || cell.strandedNoReceptor > 0 || cell.exits > 1) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+// take work from the back of the worker's own queue, or steal from the front
+// of another's
+bool Solver::popWork(int workerIdx, SolverWork & work) {
+    int workerCount = workers.size();
+
+    for(int i = 0; i < workerCount; i++) {
+        SolverWorker & worker = *workers[(workerIdx + i) % workerCount];
+        std::lock_guard<std::mutex> lock(worker.queueMutex);
+
+        if(!worker.queue.empty()) {
+            if(i == 0) {
+                work = worker.queue.back();
+                worker.queue.pop_back();
+            } else {
+                work = worker.queue.front();
+                worker.queue.pop_front();
+            }
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Solver::searchLayer(int workerIdx, int f) {
+    SolverWorker & worker = *workers[workerIdx];
+    SolverWork work;
+
+    while(!stopping) {
+        if(cancel && *cancel) {
+            cancelled = true;
+            stopping = true;
+            break;
+        }
+
+        if(!popWork(workerIdx, work)) {
+            // others may still add work to the layer
+            if(pending == 0) break;
+            std::this_thread::yield();
+            continue;
+        }
+
+        expand(worker, work, f);
+        pending--;
+    }
+}
+
+void Solver::expand(SolverWorker & worker, SolverWork work, int f) {
+    // skip stale work (node since expanded or reached in fewer moves)
+    if(!table.close(work.nodeID, work.g)) return;
+
+    if(table.getNode(work.nodeID).goal) {
+        uint32_t noGoal = NO_NODE;
+        goalNode.compare_exchange_strong(noGoal, work.nodeID);
+        stopping = true;
+        return;
+    }
+
+    worker.statesExpanded++;
+    table.getState(work.nodeID, worker.state.data());
+    decode(worker, worker.state.data());
+
+    for(SimInput input: MOVE_INPUTS) {
+        worker.level.loadState(worker.scratchState);
+        if(!worker.level.step(input)) continue;
+
+        // once merged the player can't move, so only completion counts
+        bool goal = worker.level.isCompleted();
+        if(!goal && (worker.level.getPlayer()->isMerging() || isDeadState(worker))) continue;
+
+        encode(worker, worker.childState.data());
+        uint64_t hash = worker.level.getHash();
+        uint16_t childG = work.g + 1;
+
+        uint32_t childID;
+        InsertResult inserted = table.insert(worker.childState.data(), hash,
+            SolverNode{work.nodeID, childG, (uint8_t)input, false, goal}, childID);
+
+        if(inserted == INSERT_FULL) {
+            capped = true;
+            stopping = true;
+            return;
+        }
+        if(inserted == INSERT_NONE) continue;
+
+        // the bound is consistent, so children never fall below the layer
+        int childF = childG + (goal ? 0 : heuristic(worker));
+
+        if(childF <= f) {
+            pending++;
+            std::lock_guard<std::mutex> lock(worker.queueMutex);
+            worker.queue.push_back({childID, childG});
+        } else {
+            if((int)worker.later.size() <= childF) worker.later.resize(childF + 1);
+            worker.later[childF].push_back({childID, childG});
+        }
+    }
+}
+
+SolverResult Solver::solve(int threads) {
+    return solve(workers[0]->initialState, threads);
+}
+
+SolverResult Solver::solve(const MapState & start, int threads,
+    const std::atomic<bool> * cancel) {
+
+    auto startTime = std::chrono::steady_clock::now();
+    SolverResult result;
+
+    threads = std::max(threads, 1);
+    while((int)workers.size() < threads) {
+        workers.push_back(std::make_unique<SolverWorker>(tiledMapPath));
+        workers.back()->state.resize(stateSize);
+        workers.back()->childState.resize(stateSize);
+    }
+    while((int)workers.size() > threads) workers.pop_back();
+
+    for(auto & worker: workers) {
+        worker->queue.clear();
+        worker->later.clear();
+        worker->statesExpanded = 0;
+    }
+
+    table.reset(stateSize, memoryCap);
+    layers.clear();
+    pending = 0;
+    goalNode = NO_NODE;
+    stopping = false;
+    capped = false;
+    cancelled = false;
+    this->cancel = cancel;
+
+    SolverWorker & first = *workers[0];
+    first.level.loadState(start);
+
+    if(hasPlayer() && !isDeadState(first)) {
+        encode(first, first.state.data());
+
+        uint32_t root;
+        table.insert(first.state.data(), first.level.getHash(),
+            SolverNode{NO_NODE, 0, INPUT_NONE, false, first.level.isCompleted()}, root);
+
+        layers.resize(heuristic(first) + 1);
+        layers.back().push_back({root, 0});
+    }
+
+    for(int f = 0; f < (int)layers.size() && !stopping; f++) {
+        std::vector<SolverWork> layer;
+        layer.swap(layers[f]);
+        if(layer.empty()) continue;
+
+        // deepest nodes last, so each thread dives like a DFS along a tie in f
+        std::stable_sort(layer.begin(), layer.end(),
+            [](const SolverWork & a, const SolverWork & b) { return a.g < b.g; });
+
+        for(unsigned int i = 0; i < layer.size(); i++) {
+            workers[i % threads]->queue.push_back(layer[i]);
+        }
+        pending = layer.size();
+
+        size_t queuedMemory = 0;
+        for(auto & waiting: layers) queuedMemory += waiting.capacity() * sizeof(SolverWork);
+        result.peakMemory = std::max(result.peakMemory,
+            table.memoryUsage() + queuedMemory + layer.capacity() * sizeof(SolverWork));
+        layer = std::vector<SolverWork>();
+
+        std::vector<std::thread> layerThreads;
+        for(int i = 1; i < threads; i++) {
+            layerThreads.emplace_back(&Solver::searchLayer, this, i, f);
+        }
+        searchLayer(0, f);
+
+        for(auto & thread: layerThreads) thread.join();
+
+        // gather the nodes found for later layers
+        for(auto & worker: workers) {
+            if(worker->later.size() > layers.size()) layers.resize(worker->later.size());
+
+            for(unsigned int laterF = 0; laterF < worker->later.size(); laterF++) {
+                auto & found = worker->later[laterF];
+                layers[laterF].insert(layers[laterF].end(), found.begin(), found.end());
+                found.clear();
+            }
+        }
+    }
+
+    if(goalNode != NO_NODE) {
+        for(uint32_t nodeID = goalNode; ; ) {
+            SolverNode node = table.getNode(nodeID);
+            if(node.parent == NO_NODE) break;
+
+            result.moves.push_back((SimInput)node.input);
+            nodeID = node.parent;
+        }
+        std::reverse(result.moves.begin(), result.moves.end());
+
+        result.solved = true;
+    }
+
+    for(auto & worker: workers) result.statesExpanded += worker->statesExpanded;
+
+    result.exhausted = !capped && !cancelled;
+    result.cancelled = cancelled;
+    result.threads = threads;
+    result.statesStored = table.size();
+    result.peakMemory = std::max(result.peakMemory, table.memoryUsage());
+
+    // only the result is kept, free the search's memory
+    table.reset(stateSize, memoryCap);
+    layers = std::vector<std::vector<SolverWork>>();
+    for(auto & worker: workers) worker->later = std::vector<std::vector<SolverWork>>();
+    this->cancel = nullptr;
+    result.seconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - startTime).count();
+    result.statesPerSecond = result.seconds > 0.0 ? result.statesExpanded / result.seconds : 0.0;
+
+    return result;
+}
+
+bool Solver::hasPlayer() const {
+    return workers[0]->level.getPlayer() != nullptr;
+}
+
+bool Solver::isMonotone() const {
+    return monotone;
+}
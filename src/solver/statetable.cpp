@@ -0,0 +1,150 @@
+// Implementation for the sharded transposition table
+
+#include <algorithm>
+#include <cstring>
+
+#include "solver/statetable.hpp"
+
+StateTable::StateTable() : shards(SHARDS), memoryUsed(0), nodeCount(0) {}
+
+void StateTable::reset(int stateSize, size_t memoryCap) {
+    this->stateSize = stateSize;
+    this->memoryCap = memoryCap;
+
+    size_t memory = 0;
+    // release the storage of any previous search
+    for(Shard & shard: shards) {
+        shard.states = std::vector<uint8_t>();
+        shard.nodes = std::vector<SolverNode>();
+        shard.hashes = std::vector<uint64_t>();
+        shard.table.assign(1 << 10, 0);
+        shard.table.shrink_to_fit();
+
+        memory += shard.states.capacity() + shard.nodes.capacity() * sizeof(SolverNode) +
+            shard.hashes.capacity() * sizeof(uint64_t) + shard.table.size() * sizeof(uint32_t);
+    }
+
+    memoryUsed = memory;
+    nodeCount = 0;
+}
+
+// storage grows by doubling
+size_t StateTable::growth(const Shard & shard) const {
+    size_t bytes = 0;
+
+    if(shard.states.size() + stateSize > shard.states.capacity()) {
+        bytes += std::max(shard.states.capacity(), (size_t)stateSize);
+    }
+    if(shard.nodes.size() == shard.nodes.capacity()) {
+        bytes += std::max(shard.nodes.capacity(), (size_t)1) *
+            (sizeof(SolverNode) + sizeof(uint64_t));
+    }
+    // keep the table at most half full
+    if((shard.nodes.size() + 1) * 2 > shard.table.size()) {
+        bytes += shard.table.size() * sizeof(uint32_t);
+    }
+
+    return bytes;
+}
+
+void StateTable::growTable(Shard & shard) {
+    shard.table.assign(shard.table.size() * 2, 0);
+    size_t mask = shard.table.size() - 1;
+
+    for(uint32_t nodeIdx = 0; nodeIdx < shard.nodes.size(); nodeIdx++) {
+        size_t i = (shard.hashes[nodeIdx] >> SHARD_BITS) & mask;
+        while(shard.table[i] != 0) i = (i + 1) & mask;
+        shard.table[i] = nodeIdx + 1;
+    }
+}
+
+InsertResult StateTable::insert(const uint8_t * state, uint64_t hash,
+    SolverNode node, uint32_t & nodeID) {
+
+    uint32_t shardIdx = hash & (SHARDS - 1);
+    Shard & shard = shards[shardIdx];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    size_t mask = shard.table.size() - 1;
+    size_t i = (hash >> SHARD_BITS) & mask;
+
+    for(; shard.table[i] != 0; i = (i + 1) & mask) {
+        uint32_t nodeIdx = shard.table[i] - 1;
+
+        if(shard.hashes[nodeIdx] == hash &&
+            std::memcmp(&shard.states[(size_t)nodeIdx * stateSize], state, stateSize) == 0) {
+            nodeID = (nodeIdx << SHARD_BITS) | shardIdx;
+
+            // reopen if reached in fewer moves
+            SolverNode & stored = shard.nodes[nodeIdx];
+            if(stored.closed || stored.g <= node.g) return INSERT_NONE;
+
+            stored.g = node.g;
+            stored.parent = node.parent;
+            stored.input = node.input;
+            return INSERT_IMPROVED;
+        }
+    }
+
+    // node IDs have the bits left over from the shard for the node's index
+    if(shard.nodes.size() >= (NO_NODE >> SHARD_BITS)) return INSERT_FULL;
+
+    size_t bytes = growth(shard);
+    if(bytes > 0) {
+        if(memoryUsed.fetch_add(bytes) + bytes > memoryCap) {
+            memoryUsed -= bytes;
+            return INSERT_FULL;
+        }
+
+        if((shard.nodes.size() + 1) * 2 > shard.table.size()) {
+            growTable(shard);
+
+            mask = shard.table.size() - 1;
+            i = (hash >> SHARD_BITS) & mask;
+            while(shard.table[i] != 0) i = (i + 1) & mask;
+        }
+    }
+
+    uint32_t nodeIdx = shard.nodes.size();
+    shard.nodes.push_back(node);
+    shard.hashes.push_back(hash);
+    shard.states.insert(shard.states.end(), state, state + stateSize);
+    shard.table[i] = nodeIdx + 1;
+
+    nodeCount++;
+    nodeID = (nodeIdx << SHARD_BITS) | shardIdx;
+    return INSERT_NEW;
+}
+
+bool StateTable::close(uint32_t nodeID, uint16_t g) {
+    Shard & shard = shards[nodeID & (SHARDS - 1)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    SolverNode & node = shard.nodes[nodeID >> SHARD_BITS];
+    if(node.closed || node.g != g) return false;
+
+    node.closed = true;
+    return true;
+}
+
+void StateTable::getState(uint32_t nodeID, uint8_t * state) {
+    Shard & shard = shards[nodeID & (SHARDS - 1)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    std::memcpy(state, &shard.states[(size_t)(nodeID >> SHARD_BITS) * stateSize], stateSize);
+}
+
+SolverNode StateTable::getNode(uint32_t nodeID) {
+    Shard & shard = shards[nodeID & (SHARDS - 1)];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    return shard.nodes[nodeID >> SHARD_BITS];
+}
+
+uint32_t StateTable::size() const {
+    return nodeCount;
+}
+
+size_t StateTable::memoryUsage() const {
+    return memoryUsed;
+}
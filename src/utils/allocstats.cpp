@@ -0,0 +1,23 @@
+// Replacement global operator new/delete, counting allocations (see
+// utils/allocstats.hpp). The array and nothrow forms call these.
+
+#include <cstdlib>
+#include <new>
+
+#include "utils/allocstats.hpp"
+
+void * operator new(size_t size) {
+    AllocStats::countAllocation();
+
+    void * memory = std::malloc(size ? size : 1);
+    if(!memory) throw std::bad_alloc();
+    return memory;
+}
+
+void operator delete(void * memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void * memory, size_t) noexcept {
+    std::free(memory);
+}
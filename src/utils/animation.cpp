@@ -2,17 +2,31 @@
 
 Animation::Animation(std::string animationPath, SDL_Renderer * renderer, 
     int frameWidth, int frameHeight, int msPerFrame, bool looping) : 
-    animationSpritesheet(animationPath, renderer, frameWidth, frameHeight),
+    Animation(animationPath, frameWidth, frameHeight, msPerFrame, looping) {
+    uploadTexture(renderer);
+}
+
+Animation::Animation(std::string animationPath, int frameWidth, int frameHeight,
+    int msPerFrame, bool looping) :
+    animationSpritesheet(animationPath, frameWidth, frameHeight),
     msPerFrame(msPerFrame),
     numFrames(animationSpritesheet.getNumSprites()),
     frameWidth(frameWidth), frameHeight(frameHeight),
     looping(looping) {}
 
+void Animation::uploadTexture(SDL_Renderer * renderer) {
+    animationSpritesheet.uploadTexture(renderer);
+}
+
 void Animation::render(int x, int y, int frameNum, SDL_Renderer * renderer, double angle) const {
     animationSpritesheet.getSprite(frameNum)->render(renderer, 
         (struct SDL_Rect) {x, y, frameWidth, frameHeight}, angle);
 }
 
+std::shared_ptr<Texture> Animation::getSpritesheetTexture() const {
+    return animationSpritesheet.getSpritesheetTexture();
+}
+
 int Animation::getMsPerFrame() const {
     return msPerFrame;
 }
@@ -6,8 +6,19 @@
 
 using json = nlohmann::json;
 
-BitmapFont::BitmapFont(std::string configPath, SDL_Renderer * renderer) {
-    buildFont(configPath, renderer);
+BitmapFont::BitmapFont(std::string configPath, SDL_Renderer * renderer) :
+    BitmapFont(configPath) {
+    uploadTexture(renderer);
+}
+
+BitmapFont::BitmapFont(std::string configPath) {
+    buildFont(configPath);
+}
+
+// create the font texture, and get the screen size (video calls are kept on
+// the render thread)
+void BitmapFont::uploadTexture(SDL_Renderer * renderer, bool keepSurface) {
+    bitmapTexture.uploadSurface(renderer, keepSurface);
 
     SDL_DisplayMode dm;
     SDL_GetDesktopDisplayMode(0, &dm);
@@ -15,8 +26,8 @@ BitmapFont::BitmapFont(std::string configPath, SDL_Renderer * renderer) {
     screenHeight = dm.h;
 }
 
-// build the font - load the texture + define the character clips
-void BitmapFont::buildFont(std::string configPath, SDL_Renderer * renderer) {
+// build the font - decode the texture + define the character clips
+void BitmapFont::buildFont(std::string configPath) {
     json configJSON;
     std::ifstream instream(configPath);
     instream >> configJSON;
@@ -31,7 +42,7 @@ void BitmapFont::buildFont(std::string configPath, SDL_Renderer * renderer) {
 
     auto texturePath = configPath.substr(0, lastSepIdx + 1) +
         texturePaths.back().get<std::string>();
-    bitmapTexture.loadBitmapTexture(texturePath, renderer);
+    bitmapTexture.loadSurface(texturePath, true);
 
     // retrieve common data
     auto commonData = configMap[COMMON_DATA_LABEL].get<std::map<std::string, json>>();
@@ -110,6 +121,41 @@ void BitmapFont::renderText(SDL_Renderer * renderer, const std::string & text,
     }
 }
 
+void BitmapFont::layoutText(const char * text, int x, int y,
+    std::vector<Glyph> & glyphs) const {
+
+    int currX = x, currY = y;
+
+    for(unsigned int i = 0; text[i] != '\0'; i++) {
+        int ascii = (unsigned char) text[i];
+
+        if(ascii == SPACE_CHAR) {
+            currX += spaceChar;
+        }
+
+        if(ascii == NEWLINE_CHAR || currX > screenWidth - H_PAD) {
+            currY += newLineChar;
+            currX = x;
+            continue;
+        }
+
+        auto spacing = charSpacings.find(ascii);
+        if(spacing == charSpacings.end()) continue;
+
+        currX += spacing->second.charXOffset;
+        currY += spacing->second.charYOffset;
+
+        glyphs.push_back({charClips.at(ascii), currX, currY + spacing->second.charYOffset});
+
+        currX += spacing->second.charXAdvance;
+    }
+}
+
+void BitmapFont::renderGlyphs(SDL_Renderer * renderer, const std::vector<Glyph> & glyphs) const {
+    for(auto & glyph: glyphs) {
+        bitmapTexture.render(glyph.x, glyph.y, renderer, &glyph.clip);
+    }
+}
 
 // if already rendering typed text call these functions
 void BitmapFont::updateText(float delta) {
@@ -145,6 +191,10 @@ void BitmapFont::setAlpha(Uint8 a) {
     bitmapTexture.setAlpha(a);
 }
 
+Texture * BitmapFont::getBitmapTexture() {
+    return &bitmapTexture;
+}
+
 bool BitmapFont::isRenderingDynamic() const {
     return renderingDynamic;
 }
@@ -0,0 +1,83 @@
+// Implementation for the frame time histogram
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "utils/framehistogram.hpp"
+
+int FrameHistogram::bucketIndex(uint64_t value) {
+    // exact below SUB_BUCKETS
+    if(value < (uint64_t)SUB_BUCKETS) return value;
+
+    int highBit = 63;
+    while(!(value >> highBit)) highBit--;
+
+    // SUB_BUCKETS buckets per power of 2 (the top SUB_BITS + 1 bits)
+    int shift = highBit - SUB_BITS;
+    int index = SUB_BUCKETS + shift * SUB_BUCKETS + (int)((value >> shift) - SUB_BUCKETS);
+
+    return std::min(index, NUM_BUCKETS - 1);
+}
+
+uint64_t FrameHistogram::bucketValue(int index) {
+    if(index < SUB_BUCKETS) return index;
+
+    int shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+    uint64_t sub = (index - SUB_BUCKETS) % SUB_BUCKETS + SUB_BUCKETS;
+
+    return ((sub + 1) << shift) - 1;
+}
+
+void FrameHistogram::record(uint64_t us) {
+    counts[bucketIndex(us)]++;
+    totalCount++;
+    maxValue = std::max(maxValue, us);
+}
+
+uint64_t FrameHistogram::percentile(double fraction) const {
+    if(totalCount == 0) return 0;
+
+    uint64_t target = std::max((uint64_t)std::ceil(fraction * totalCount), (uint64_t)1);
+    uint64_t seen = 0;
+
+    for(int i = 0; i < NUM_BUCKETS; i++) {
+        seen += counts[i];
+        if(seen >= target) return std::min(bucketValue(i), maxValue);
+    }
+
+    return maxValue;
+}
+
+uint64_t FrameHistogram::getMax() const {
+    return maxValue;
+}
+
+uint64_t FrameHistogram::getCount() const {
+    return totalCount;
+}
+
+bool FrameHistogram::save(const std::string & path) const {
+    FILE * file = fopen(path.c_str(), "w");
+    if(!file) {
+        printf("Error writing frame times to %s\n", path.c_str());
+        return false;
+    }
+
+    fprintf(file, "# frames %llu, p50 %llu us, p90 %llu us, p99 %llu us, p99.9 %llu us, "
+        "max %llu us\n", (unsigned long long)totalCount,
+        (unsigned long long)percentile(0.5), (unsigned long long)percentile(0.9),
+        (unsigned long long)percentile(0.99), (unsigned long long)percentile(0.999),
+        (unsigned long long)maxValue);
+    fprintf(file, "# frame time (us, bucket's upper bound) and count\n");
+
+    for(int i = 0; i < NUM_BUCKETS; i++) {
+        if(counts[i]) {
+            fprintf(file, "%llu %llu\n", (unsigned long long)bucketValue(i),
+                (unsigned long long)counts[i]);
+        }
+    }
+
+    fclose(file);
+    return true;
+}
@@ -0,0 +1,93 @@
+// Implementation for the profiler (only built with PROFILING defined)
+
+#ifdef PROFILING
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "utils/profiler.hpp"
+
+ProfileSample Profiler::samples[CAPACITY];
+
+uint32_t Profiler::threadID() {
+    thread_local uint32_t id = nextThread.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+int64_t Profiler::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void Profiler::record(const char * name, int64_t start, int64_t end) {
+    uint64_t index = nextSample.fetch_add(1, std::memory_order_relaxed);
+    ProfileSample & sample = samples[index % CAPACITY];
+
+    // mark as being written before overwriting
+    sample.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    sample.name = name;
+    sample.start = start;
+    sample.duration = end - start;
+    sample.thread = threadID();
+
+    sample.sequence.store(index + 1, std::memory_order_release);
+}
+
+bool Profiler::dump(const std::string & path, double seconds) {
+    struct Sample {
+        const char * name;
+        int64_t start;
+        int64_t duration;
+        uint32_t thread;
+    };
+
+    int64_t since = now() - (int64_t)(seconds * 1e9);
+    std::vector<Sample> recent;
+
+    // copy the samples, skipping any being written meanwhile
+    for(ProfileSample & sample: samples) {
+        uint64_t sequence = sample.sequence.load(std::memory_order_acquire);
+        if(sequence == 0) continue;
+
+        Sample copy = {sample.name, sample.start, sample.duration, sample.thread};
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(sample.sequence.load(std::memory_order_relaxed) != sequence) continue;
+
+        if(copy.start + copy.duration >= since) {
+            recent.push_back(copy);
+        }
+    }
+
+    std::sort(recent.begin(), recent.end(), [](const Sample & a, const Sample & b) {
+        return a.start < b.start;
+    });
+
+    FILE * file = fopen(path.c_str(), "w");
+    if(!file) {
+        printf("Error writing profile to %s\n", path.c_str());
+        return false;
+    }
+
+    // complete ("X") events, in us from the first sample
+    int64_t origin = recent.empty() ? 0 : recent.front().start;
+
+    fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    for(unsigned int i = 0; i < recent.size(); i++) {
+        fprintf(file, "{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %u, "
+            "\"ts\": %.3f, \"dur\": %.3f}%s\n", recent[i].name, recent[i].thread,
+            (recent[i].start - origin) / 1e3, recent[i].duration / 1e3,
+            i + 1 < recent.size() ? "," : "");
+    }
+    fprintf(file, "]}\n");
+
+    fclose(file);
+    printf("Wrote %zu profile samples to %s\n", recent.size(), path.c_str());
+    return true;
+}
+
+#endif // PROFILING
@@ -1,5 +1,8 @@
 // Resource manager class
 
+#include <algorithm>
+
+#include "utils/profiler.hpp"
 #include "utils/resmanager.hpp"
 
 // Construct the resource manager with a path to file containing the
@@ -11,6 +14,18 @@ ResManager::ResManager(std::string resourcePathsFile, SDL_Renderer * renderer):
     
 }
 
+// stop loading (if quitting during the splash screen)
+ResManager::~ResManager() {
+    {
+        std::lock_guard<std::mutex> lock(loadMutex);
+        resourcesToLoad.clear();
+    }
+
+    for(auto & thread: loaderThreads) {
+        thread.join();
+    }
+}
+
 void ResManager::parseJSON(std::string resourcePathsFile) {
     // load the json string to the resourcePaths json obj.
     json jsonRes;
@@ -32,14 +47,19 @@ void ResManager::parseJSON(std::string resourcePathsFile) {
             resPath = RES_FOLDER_NAME + PATH_SEP + jsonObj.first +
                 PATH_SEP + resPath;
 
-            int resHashID = resHash(res.first);
+            uint64_t resHashID = ResId(res.first).hash;
 
-            resourcePaths.emplace(resHashID, resPath);
+            // levels are loaded from their compiled form when it's up to date
+            if(jsonObj.first == RES_MAPS_NAME) {
+                addResourcePath(res.first, getLevelPath(resPath));
+            } else {
+                addResourcePath(res.first, resPath);
+            }
 
             // add to stack of resources to load if not map or is 0-0 map
             if(jsonObj.first != RES_MAPS_NAME) {
                 resourcesToLoad.push_back(resHashID);
-            } else if(res.first == BASE_MAP_ID) {
+            } else if(ResId(res.first) == BASE_MAP_ID) {
                 // add each spritesheet resource from the first base map "0-0"
                 tmx::Map map;
 
@@ -47,10 +67,10 @@ void ResManager::parseJSON(std::string resourcePathsFile) {
                     const auto & readTilesets = map.getTilesets();
                     for(const auto & tileset: readTilesets) {
                         // hash the name of the tileset
-                        int ssHashID = resHash(tileset.getName());
+                        uint64_t ssHashID = ResId(tileset.getName()).hash;
                         
                         // add map path and hashed ID to resources to load
-                        resourcePaths.emplace(ssHashID, resPath);
+                        addResourcePath(tileset.getName(), resPath);
                         resourcesToLoad.push_back(ssHashID);
 
                         tilesetNames.emplace(ssHashID, tileset.getName());
@@ -61,32 +81,59 @@ void ResManager::parseJSON(std::string resourcePathsFile) {
     }
 }
 
-// load all resources
-void ResManager::loadNextResource() {
-    int currResID = resourcesToLoad.back();
-    resourcesToLoad.pop_back();
+// (the IDs in res_paths.json are checked for collisions at build time, see
+// utils/resids.hpp, but not the tileset names)
+void ResManager::addResourcePath(const std::string & id, const std::string & path) {
+    if(!resourcePaths.emplace(ResId(id).hash, path).second) {
+        printf("Resource ID %s collides with another resource's, it won't be loaded\n",
+            id.c_str());
+    }
+}
 
-    std::string currResFilepath = resourcePaths.at(currResID);
+// start the loader threads
+void ResManager::startLoading() {
+    resourcesTotal = resourcesToLoad.size();
 
-    // get file extension to determine resource type
-    std::string resFileExt = getResExt(currResFilepath);
+    // fonts are popped (loaded) first, for the splash screen
+    std::stable_partition(resourcesToLoad.begin(), resourcesToLoad.end(), [&](uint64_t resID) {
+        return getResExt(resourcePaths.at(resID)) != FONT_EXT;
+    });
 
-    if(resFileExt == ANIMATION_EXT) {
-        loadAnimation(currResID, currResFilepath);
-    } else if(resFileExt == IMAGE_EXT) {
-        loadTexture(currResID, currResFilepath);
-    } else if (resFileExt == MAP_EXT) {
-        loadSpritesheet(currResID, currResFilepath);
-    } else if (resFileExt == SOUND_EXT) {
-        loadSound(currResID, currResFilepath);
-    } else if (resFileExt == MUSIC_EXT) {
-        loadMusic(currResID, currResFilepath);
-    } else if (resFileExt == FONT_EXT) {
-        loadFont(currResID, currResFilepath);
+    int numThreads = std::max((int)std::thread::hardware_concurrency() - 1, 1);
+    for(int i = 0; i < numThreads; i++) {
+        loaderThreads.emplace_back(&ResManager::loadResources, this);
+    }
+}
+
+// store the resources decoded since the last call, up to a batch
+void ResManager::uploadLoadedResources() {
+    PROFILE_ZONE("ResManager::uploadLoadedResources");
+
+    std::vector<std::function<void()>> batch;
+    {
+        std::lock_guard<std::mutex> lock(loadMutex);
+
+        int batchSize = std::min((int)decodedResources.size(), UPLOAD_BATCH_SIZE);
+        batch.assign(decodedResources.begin(), decodedResources.begin() + batchSize);
+        decodedResources.erase(decodedResources.begin(), decodedResources.begin() + batchSize);
+    }
+
+    for(auto & storeResource: batch) {
+        storeResource();
+        resourcesStored++;
     }
 
     // check if finished
-    if(!loadingResources()) {
+    if(!batch.empty() && !loadingResources()) {
+        for(auto & thread: loaderThreads) {
+            thread.join();
+        }
+        loaderThreads.clear();
+
+        // upload the textures, packed into atlases
+        textureAtlas.build(atlasTextures, renderer);
+        atlasTextures.clear();
+
         // construct animation maps
         constructAnimationMaps();
 
@@ -96,36 +143,84 @@ void ResManager::loadNextResource() {
     }
 }
 
-// load a standalone texture
-void ResManager::loadTexture(int resourceIDHash, std::string resourcePath) {
-    auto texture = std::make_shared<Texture>();
-    texture->loadTexture(resourcePath, renderer);
+// decode resources until there are none left (on a loader thread)
+void ResManager::loadResources() {
+    while(true) {
+        uint64_t currResID;
+        {
+            std::lock_guard<std::mutex> lock(loadMutex);
+            if(resourcesToLoad.empty()) return;
 
-    textures.emplace(resourceIDHash, texture);
-}
+            currResID = resourcesToLoad.back();
+            resourcesToLoad.pop_back();
+        }
 
-// load a spritesheet via tutorial tiledmap (from resourcePath)
-void ResManager::loadSpritesheet(int resourceIDHash, std::string resourcePath) {    
-    spritesheets.emplace(resourceIDHash, 
-        std::make_shared<SpriteSheet>(resourcePath, tilesetNames[resourceIDHash], renderer));
-}
+        // (the path/tileset maps aren't modified while loading)
+        auto storeResource = loadResource(currResID, resourcePaths.at(currResID));
 
-void ResManager::loadSound(int resourceIDHash, std::string resourcePath) {
-    sounds.emplace(resourceIDHash, std::make_shared<Sound>(resourcePath));
+        std::lock_guard<std::mutex> lock(loadMutex);
+        decodedResources.push_back(storeResource);
+    }
 }
 
-void ResManager::loadMusic(int resourceIDHash, std::string resourcePath) {
-    musics.emplace(resourceIDHash, std::make_shared<Music>(resourcePath));
-}
+// decode a resource, determining its type by its path
+std::function<void()> ResManager::loadResource(uint64_t resourceIDHash, std::string resourcePath) {
+    PROFILE_ZONE("ResManager::loadResource");
 
-void ResManager::loadFont(int resourceIDHash, std::string resourcePath) {
-    // pass path to font json (config) file
-    fonts.emplace(resourceIDHash, std::make_shared<BitmapFont>(resourcePath, renderer));
-}
+    // get file extension to determine resource type
+    std::string resFileExt = getResExt(resourcePath);
+
+    if(resFileExt == ANIMATION_EXT) {
+        auto animation = std::make_shared<Animation>(resourcePath,
+            ANIM_FRAMEWIDTH, ANIM_FRAMEHEIGHT);
+
+        return [this, resourceIDHash, animation]() {
+            atlasTextures.push_back(animation->getSpritesheetTexture().get());
+            animations.emplace(resourceIDHash, animation);
+        };
+    } else if(resFileExt == IMAGE_EXT) {
+        auto texture = std::make_shared<Texture>();
+        texture->loadSurface(resourcePath);
+
+        return [this, resourceIDHash, texture]() {
+            atlasTextures.push_back(texture.get());
+            textures.emplace(resourceIDHash, texture);
+        };
+    } else if (resFileExt == MAP_EXT) {
+        // spritesheet via tiledmap (from resourcePath)
+        auto spritesheet = std::make_shared<SpriteSheet>(resourcePath,
+            tilesetNames.at(resourceIDHash));
+
+        return [this, resourceIDHash, spritesheet]() {
+            atlasTextures.push_back(spritesheet->getSpritesheetTexture().get());
+            spritesheets.emplace(resourceIDHash, spritesheet);
+        };
+    } else if (resFileExt == SOUND_EXT) {
+        auto sound = std::make_shared<Sound>(resourcePath);
+
+        return [this, resourceIDHash, sound]() {
+            soundIndices.emplace(resourceIDHash, sounds.size());
+            sounds.push_back(sound);
+        };
+    } else if (resFileExt == MUSIC_EXT) {
+        auto music = std::make_shared<Music>(resourcePath);
+
+        return [this, resourceIDHash, music]() {
+            musics.emplace(resourceIDHash, music);
+        };
+    } else if (resFileExt == FONT_EXT) {
+        // pass path to font json (config) file
+        auto font = std::make_shared<BitmapFont>(resourcePath);
+
+        // (uploaded right away for the splash screen, but still packed later)
+        return [this, resourceIDHash, font]() {
+            font->uploadTexture(renderer, true);
+            atlasTextures.push_back(font->getBitmapTexture());
+            fonts.emplace(resourceIDHash, font);
+        };
+    }
 
-void ResManager::loadAnimation(int resourceIDHash, std::string resourcePath) {
-    animations.emplace(resourceIDHash, 
-        std::make_shared<Animation>(resourcePath, renderer, ANIM_FRAMEWIDTH, ANIM_FRAMEHEIGHT));
+    return []() {};
 }
 
 void ResManager::constructAnimationMaps() {
@@ -148,7 +243,39 @@ void ResManager::constructAnimationMaps() {
 
 // return whether done loading resources
 bool ResManager::loadingResources() const {
-    return !resourcesToLoad.empty();
+    return resourcesStored < resourcesTotal;
+}
+
+float ResManager::getLoadProgress() const {
+    return resourcesTotal > 0 ? (float)resourcesStored / resourcesTotal : 1.f;
+}
+
+// path to load a level (tiledmap) from: its compiled level (same path, .lvl
+// extension) if there's one at least as new as the tiledmap and the tilesets
+// beside it (their parities/properties are compiled in), else the tiledmap
+std::string ResManager::getLevelPath(std::string tiledMapPath) {
+    std::string compiledMapPath = tiledMapPath.substr(0, tiledMapPath.find_last_of('.')) +
+        COMPILED_MAP_EXT;
+
+    std::error_code error;
+    auto compiledTime = std::filesystem::last_write_time(compiledMapPath, error);
+    if(error) return tiledMapPath;
+
+    auto tiledTime = std::filesystem::last_write_time(tiledMapPath, error);
+    if(error || compiledTime < tiledTime) return tiledMapPath;
+
+    auto mapDir = std::filesystem::path(tiledMapPath).parent_path();
+    if(mapDir.empty()) mapDir = ".";
+
+    for(auto & entry: std::filesystem::directory_iterator(mapDir, error)) {
+        if(entry.path().extension() != TILESET_EXT) continue;
+
+        auto tilesetTime = entry.last_write_time(error);
+        if(error || compiledTime < tilesetTime) return tiledMapPath;
+    }
+    if(error) return tiledMapPath;
+
+    return compiledMapPath;
 }
 
 // helper function to get the resource extension from a path
@@ -162,34 +289,46 @@ std::string ResManager::getResExt(std::string path) {
 }
 
 // to retrieve resources, call w/resource id
-std::shared_ptr<Texture> ResManager::getTexture(std::string id) const {
-    return textures.at(resHash(id));
+std::shared_ptr<Texture> ResManager::getTexture(ResId id) const {
+    return textures.at(id.hash);
+}
+
+std::shared_ptr<SpriteSheet> ResManager::getSpriteSheet(ResId id) const {
+    return spritesheets.at(id.hash);
 }
 
-std::shared_ptr<SpriteSheet> ResManager::getSpriteSheet(std::string id) const {
-    return spritesheets.at(resHash(id));
+
+std::shared_ptr<Sound> ResManager::getSound(ResId id) const {
+    return sounds.at(soundIndices.at(id.hash));
 }
 
+SoundHandle ResManager::getSoundHandle(ResId id) const {
+    return {soundIndices.at(id.hash)};
+}
+
+const std::shared_ptr<Sound> & ResManager::getSound(SoundHandle sound) const {
+    return sounds[sound.index];
+}
 
-std::shared_ptr<Sound> ResManager::getSound(std::string id) const {
-    return sounds.at(resHash(id));
+std::shared_ptr<Music> ResManager::getMusic(ResId id) const {
+    return musics.at(id.hash);
 }
 
-std::shared_ptr<Music> ResManager::getMusic(std::string id) const {
-    return musics.at(resHash(id));
+std::shared_ptr<BitmapFont> ResManager::getFont(ResId id) const {
+    return fonts.at(id.hash);
 }
 
-std::shared_ptr<BitmapFont> ResManager::getFont(std::string id) const {
-    return fonts.at(resHash(id));
+bool ResManager::hasFont(ResId id) const {
+    return fonts.find(id.hash) != fonts.end();
 }
 
-std::shared_ptr<Animation> ResManager::getAnimation(std::string id) const {
-    return animations.at(resHash(id));
+std::shared_ptr<Animation> ResManager::getAnimation(ResId id) const {
+    return animations.at(id.hash);
 }
 
 // Return the actual path to the file containing the resource with ID id
-std::string ResManager::getResPath(std::string id) const {
-    return resourcePaths.at(resHash(id));
+const std::string & ResManager::getResPath(ResId id) const {
+    return resourcePaths.at(id.hash);
 }
 
 const std::unordered_map<int, std::shared_ptr<Animation>> & ResManager::getTileAnimations() const {
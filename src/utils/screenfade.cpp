@@ -0,0 +1,60 @@
+#include <algorithm>
+
+#include "utils/screenfade.hpp"
+
+ScreenFade::ScreenFade() {}
+
+void ScreenFade::start(std::function<void()> onFaded) {
+    if(phase != FADE_NONE) return;
+
+    this->onFaded = onFaded;
+    phase = FADE_OUT;
+    opacity = 0.f;
+}
+
+void ScreenFade::fadeIn() {
+    onFaded = nullptr;
+    phase = FADE_IN;
+    opacity = OPACITY_MAX;
+}
+
+void ScreenFade::update(float delta) {
+    float step = OPACITY_MAX * std::min(delta, MAX_STEP_MS) / FADE_MS;
+
+    if(phase == FADE_OUT) {
+        opacity += step;
+
+        // once black, run the callback (which may take a while) and fade in
+        if(opacity >= OPACITY_MAX) {
+            opacity = OPACITY_MAX;
+            phase = FADE_IN;
+
+            std::function<void()> faded = std::move(onFaded);
+            onFaded = nullptr;
+            if(faded) faded();
+        }
+    } else if(phase == FADE_IN) {
+        opacity -= step;
+
+        if(opacity <= 0.f) {
+            opacity = 0.f;
+            phase = FADE_NONE;
+        }
+    }
+}
+
+// cover the screen in black at the current opacity
+void ScreenFade::render(SDL_Renderer * renderer, int width, int height) const {
+    if(phase == FADE_NONE) return;
+
+    SDL_Rect screenArea = {0, 0, width, height};
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, (Uint8)opacity);
+    SDL_RenderFillRect(renderer, &screenArea);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+}
+
+bool ScreenFade::isFading() const {
+    return phase != FADE_NONE;
+}
@@ -6,8 +6,7 @@ Sprite::Sprite(std::shared_ptr<Texture> spritesheet, const SDL_Rect & clip) :
 // render the sprite at the specified area
 void Sprite::render(SDL_Renderer * renderer, const SDL_Rect & renderArea,
     double angle, SDL_Point * center, SDL_RendererFlip flip) const {
-    SDL_RenderCopyEx(renderer, spritesheet->getTexture().get(), &spriteClip, 
-        &renderArea, angle, center, flip);
+    spritesheet->render(renderer, &spriteClip, renderArea, angle, center, flip);
 }
 
 int Sprite::getWidth() const {
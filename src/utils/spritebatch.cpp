@@ -0,0 +1,98 @@
+// Implementation for SpriteBatch
+
+#include <cmath>
+#include <utility>
+
+#include "utils/renderstats.hpp"
+#include "utils/spritebatch.hpp"
+
+void SpriteBatch::begin(SDL_Renderer * renderer) {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if(enabled) SpriteBatch::renderer = renderer;
+#endif
+}
+
+void SpriteBatch::flush() {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if(vertices.empty()) return;
+
+    // (texture color/alpha mods are ignored by geometry, the vertex colors
+    // hold them instead)
+    SDL_SetTextureBlendMode(texture, blendMode);
+
+    RenderStats::countDraw(texture);
+    SDL_RenderGeometry(renderer, texture, vertices.data(), vertices.size(),
+        indices.data(), indices.size());
+
+    vertices.clear();
+    indices.clear();
+#endif
+}
+
+void SpriteBatch::end() {
+    flush();
+
+    renderer = nullptr;
+    texture = nullptr;
+}
+
+void SpriteBatch::add(SDL_Texture * texture, SDL_BlendMode blendMode,
+    const SDL_Rect & source, const SDL_Rect & renderArea, SDL_Color color,
+    double angle, const SDL_Point * center, SDL_RendererFlip flip) {
+    // quads of another texture can't go in the same call
+    if(texture != SpriteBatch::texture || blendMode != SpriteBatch::blendMode) {
+        flush();
+
+        int width = 0, height = 0;
+        SDL_QueryTexture(texture, NULL, NULL, &width, &height);
+
+        SpriteBatch::texture = texture;
+        SpriteBatch::blendMode = blendMode;
+        texelWidth = width > 0 ? 1.f / width : 0.f;
+        texelHeight = height > 0 ? 1.f / height : 0.f;
+    }
+
+    // texture coords of the clip, swapped to flip it
+    float u0 = source.x * texelWidth, u1 = (source.x + source.w) * texelWidth;
+    float v0 = source.y * texelHeight, v1 = (source.y + source.h) * texelHeight;
+
+    if(flip & SDL_FLIP_HORIZONTAL) std::swap(u0, u1);
+    if(flip & SDL_FLIP_VERTICAL) std::swap(v0, v1);
+
+    // corners relative to the center of rotation (the middle of the render
+    // area by default)
+    float centerX = center != NULL ? center->x : renderArea.w / 2.f;
+    float centerY = center != NULL ? center->y : renderArea.h / 2.f;
+    float originX = renderArea.x + centerX, originY = renderArea.y + centerY;
+
+    float left = -centerX, right = renderArea.w - centerX;
+    float top = -centerY, bottom = renderArea.h - centerY;
+
+    SDL_FPoint corners[4] = {{left, top}, {right, top}, {right, bottom}, {left, bottom}};
+
+    // rotate clockwise (as SDL_RenderCopyEx does)
+    if(angle != 0.0) {
+        float radians = angle * PI / 180.0;
+        float c = std::cos(radians), s = std::sin(radians);
+
+        for(SDL_FPoint & corner: corners) {
+            corner = {c * corner.x - s * corner.y, s * corner.x + c * corner.y};
+        }
+    }
+
+    int first = vertices.size();
+    const SDL_FPoint texCoords[4] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+
+    for(int i = 0; i < 4; i++) {
+        vertices.push_back({{originX + corners[i].x, originY + corners[i].y}, color,
+            texCoords[i]});
+    }
+
+    for(int i: {0, 1, 2, 0, 2, 3}) {
+        indices.push_back(first + i);
+    }
+}
+
+void SpriteBatch::setEnabled(bool enabled) {
+    SpriteBatch::enabled = enabled;
+}
@@ -3,16 +3,19 @@
 #include "utils/spritesheet.hpp"
 
 SpriteSheet::SpriteSheet(std::string texturePath, SDL_Renderer * renderer,
-    int spriteWidth, int spriteHeight) : spritesheetTexture(new Texture()) {
-    loadSpritesheet(texturePath, renderer, spriteWidth, spriteHeight);
+    int spriteWidth, int spriteHeight) : SpriteSheet(texturePath, spriteWidth, spriteHeight) {
+    uploadTexture(renderer);
 }
 
-// load directly from an image texture w / specified params
-void SpriteSheet::loadSpritesheet(std::string texturePath, SDL_Renderer * renderer,
-    int spriteWidth, int spriteHeight) {
+SpriteSheet::SpriteSheet(std::string texturePath, int spriteWidth, int spriteHeight) :
+    spritesheetTexture(new Texture()) {
+    loadSpritesheet(texturePath, spriteWidth, spriteHeight);
+}
 
-    // load the texture
-    spritesheetTexture->loadTexture(texturePath, renderer);
+// load directly from an image texture w / specified params
+void SpriteSheet::loadSpritesheet(std::string texturePath, int spriteWidth, int spriteHeight) {
+    // decode the texture image
+    spritesheetTexture->loadSurface(texturePath);
 
     // assumes the texture contains n sprites of size spriteWidth x spriteHeight in one row
     int numSprites = spritesheetTexture->getWidth() / spriteWidth;
@@ -28,14 +31,17 @@ void SpriteSheet::loadSpritesheet(std::string texturePath, SDL_Renderer * render
 }
 
 SpriteSheet::SpriteSheet(std::string mapPath, std::string tilesetName, 
-    SDL_Renderer * renderer) : spritesheetTexture(new Texture()) {
-    
-    loadSpritesheet(mapPath, tilesetName, renderer);
+    SDL_Renderer * renderer) : SpriteSheet(mapPath, tilesetName) {
+    uploadTexture(renderer);
+}
+
+SpriteSheet::SpriteSheet(std::string mapPath, std::string tilesetName) :
+    spritesheetTexture(new Texture()) {
+    loadSpritesheet(mapPath, tilesetName);
 }
     
 // load a spritesheet from a tiledmap
-void SpriteSheet::loadSpritesheet(std::string mapPath, std::string tilesetName, 
-    SDL_Renderer * renderer) {
+void SpriteSheet::loadSpritesheet(std::string mapPath, std::string tilesetName) {
 
     tmx::Map map;
 
@@ -45,8 +51,8 @@ void SpriteSheet::loadSpritesheet(std::string mapPath, std::string tilesetName,
         for(const auto & tileset: readTilesets) {
             // check matching tileset names
             if(tileset.getName() == tilesetName) {
-                // load the texture
-                spritesheetTexture->loadTexture(tileset.getImagePath(), renderer);
+                // decode the texture image
+                spritesheetTexture->loadSurface(tileset.getImagePath());
 
                 // store first GID
                 firstGID = tileset.getFirstGID();
@@ -56,7 +62,7 @@ void SpriteSheet::loadSpritesheet(std::string mapPath, std::string tilesetName,
 
                 // construct sprites for each tile in the spritesheet
                 for(auto & tile: tiles) {
-                    loadTileProperties(tile);
+                    tileProperties.loadTileProperties(tile);
 
                     // Get position/size of tile in the tileset to create the sprite/clip
                     int tilesetX = tile.imagePosition.x;
@@ -77,48 +83,8 @@ void SpriteSheet::loadSpritesheet(std::string mapPath, std::string tilesetName,
     }    
 }
 
-void SpriteSheet::loadTileProperties(const tmx::Tileset::Tile & tile) {
-    // check/store this tile's properties if nonempty
-    auto & properties = tile.properties;
-
-    if(!properties.empty()) {
-        std::map<std::string, std::any> propertyMap;
-
-        for(auto & property: properties) {
-            std::string propName = property.getName();
-            tmx::Property::Type type = property.getType();
-
-            switch(type) {
-                case tmx::Property::Type::Boolean:
-                    propertyMap.emplace(propName,
-                        std::any_cast<bool>(property.getBoolValue()));
-                    break;
-                case tmx::Property::Type::Float:
-                    propertyMap.emplace(propName, 
-                        std::any_cast<float>(property.getFloatValue()));
-                    break;
-                case tmx::Property::Type::Int:
-                    propertyMap.emplace(propName, 
-                        std::any_cast<int>(property.getIntValue()));
-                    break;
-                case tmx::Property::Type::String:
-                    propertyMap.emplace(propName,
-                        std::any_cast<std::string>(property.getStringValue()));
-                    break;
-                case tmx::Property::Type::Colour:
-                    propertyMap.emplace(propName,
-                        std::any_cast<tmx::Colour>(property.getColourValue()));
-                    break;
-                case tmx::Property::Type::File:
-                    propertyMap.emplace(propName, 
-                        std::any_cast<std::string>(property.getFileValue()));
-                    break;
-                case tmx::Property::Type::Undef:
-                    break;                    
-            } 
-        }
-        tileProperties.emplace(tile.ID, propertyMap);
-    }
+void SpriteSheet::uploadTexture(SDL_Renderer * renderer) {
+    spritesheetTexture->uploadSurface(renderer);
 }
 
 // get the clip in this spritesheet for the given tile (as SDL_Rect wrapper Sprite obj.) 
@@ -134,6 +100,10 @@ SDL_Texture * SpriteSheet::getTexture() const {
     return spritesheetTexture->getTexture().get();
 }
 
+std::shared_ptr<Texture> SpriteSheet::getSpritesheetTexture() const {
+    return spritesheetTexture;
+}
+
 int SpriteSheet::getNumSprites() const {
     return sprites.size();
 }
\ No newline at end of file
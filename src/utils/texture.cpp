@@ -1,45 +1,57 @@
 // Implementation for Texture class
 
+#include "utils/renderstats.hpp"
+#include "utils/spritebatch.hpp"
 #include "utils/texture.hpp"
 
 Texture::Texture() {}
 
 /// image texture constructor
 void Texture::loadTexture(std::string path, SDL_Renderer* renderer) {
-    SDL_Surface * surface = IMG_Load(path.c_str());
-    if(!surface) {
-        return;
+    if(loadSurface(path)) {
+        uploadSurface(renderer);
     }
+}
 
-    // Create SDL texture from the surface
-    std::shared_ptr<SDL_Texture> newTexture 
-        (SDL_CreateTextureFromSurface(renderer, surface), SDL_DestroyTexture);
-        
-    if(!newTexture.get()) {
-        printf("Error creating texture, %s", SDL_GetError());
+void Texture::loadBitmapTexture(std::string path, SDL_Renderer * renderer) {
+    if(loadSurface(path, true)) {
+        uploadSurface(renderer);
     }
+}
 
-    texture = newTexture;
+// decode the image at path, to be uploaded later
+bool Texture::loadSurface(std::string path, bool bitmap) {
+    surface = std::shared_ptr<SDL_Surface>(IMG_Load(path.c_str()), SDL_FreeSurface);
+    if(!surface.get()) {
+        return false;
+    }
+
+    // set black color key
+    if(bitmap) {
+        SDL_SetColorKey(surface.get(), SDL_TRUE, SDL_MapRGB(surface->format, 0, 0, 0));
+    }
+
+    this->bitmap = bitmap;
 
     width = surface->w;
     height = surface->h;
+    region = {0, 0, width, height};
 
-    SDL_FreeSurface(surface);
+    return true;
 }
 
-void Texture::loadBitmapTexture(std::string path, SDL_Renderer * renderer) {
-    SDL_Surface * surface = IMG_Load(path.c_str());
-    if(!surface) {
+// create the texture from the decoded image (must be on the render thread),
+// keeping the image if it's still needed (eg. to pack into an atlas later)
+void Texture::uploadSurface(SDL_Renderer * renderer, bool keepSurface) {
+    if(!surface.get()) {
         return;
     }
 
-    // set black color key
-    SDL_SetColorKey(surface, SDL_TRUE, SDL_MapRGB(surface->format, 0, 0, 0));
-
     // Create SDL texture from the surface
-    std::shared_ptr<SDL_Texture> newTexture (SDL_CreateTextureFromSurface(renderer, 
-        surface), SDL_DestroyTexture);
-        
+    std::shared_ptr<SDL_Texture> newTexture 
+        (SDL_CreateTextureFromSurface(renderer, surface.get()), SDL_DestroyTexture);
+    if(!keepSurface) surface.reset();
+
     if(!newTexture.get()) {
         printf("Error creating texture, %s", SDL_GetError());
         return;
@@ -47,13 +59,29 @@ void Texture::loadBitmapTexture(std::string path, SDL_Renderer * renderer) {
 
     texture = newTexture;
 
-    width = surface->w;
-    height = surface->h;
-
     // enable blending for flashing text
-    setBlendMode(SDL_BLENDMODE_BLEND);
+    if(bitmap) {
+        setBlendMode(SDL_BLENDMODE_BLEND);
+    }
+}
+
+SDL_Surface * Texture::getSurface() const {
+    return surface.get();
+}
+
+void Texture::setAtlasRegion(std::shared_ptr<SDL_Texture> atlas, const SDL_Rect & region) {
+    texture = atlas;
+    this->region = region;
+    atlased = true;
+
+    surface.reset();
+}
 
-    SDL_FreeSurface(surface);
+// set this texture's modulation/blending on the shared atlas texture
+void Texture::applyModulation() const {
+    SDL_SetTextureColorMod(texture.get(), colorMod.r, colorMod.g, colorMod.b);
+    SDL_SetTextureAlphaMod(texture.get(), textureAlpha);
+    SDL_SetTextureBlendMode(texture.get(), blendMode);
 }
 
 /**
@@ -76,7 +104,29 @@ void Texture::render(int x, int y, SDL_Renderer * renderer, const SDL_Rect * cli
         renderArea.h = clip->h;
     }
 
-    SDL_RenderCopyEx(renderer, texture.get(), clip, &renderArea, angle, center, flip);
+    render(renderer, clip, renderArea, angle, center, flip);
+}
+
+void Texture::render(SDL_Renderer * renderer, const SDL_Rect * clip, const SDL_Rect & renderArea,
+    double angle, SDL_Point * center, SDL_RendererFlip flip) const {
+    // clips are relative to this texture's region of the SDL texture
+    SDL_Rect source = region;
+    if(clip != NULL) {
+        source = {region.x + clip->x, region.y + clip->y, clip->w, clip->h};
+    }
+
+    // batched draws are modulated/blended by the batch (see SpriteBatch)
+    if(SpriteBatch::isBatching(renderer)) {
+        SDL_Color color = {colorMod.r, colorMod.g, colorMod.b, textureAlpha};
+        SpriteBatch::add(texture.get(), blendMode, source, renderArea, color,
+            angle, center, flip);
+        return;
+    }
+
+    if(atlased) applyModulation();
+
+    RenderStats::countDraw(texture.get());
+    SDL_RenderCopyEx(renderer, texture.get(), &source, &renderArea, angle, center, flip);
 }
 
 // lock texture; return true if successful
@@ -120,13 +170,15 @@ void * Texture::getPixels() {
 }
 
 void Texture::setColor(Uint8 red, Uint8 green, Uint8 blue) {
-    SDL_SetTextureColorMod(texture.get(), red, green, blue);
+    colorMod = {red, green, blue, 0xFF};
+    if(!atlased) SDL_SetTextureColorMod(texture.get(), red, green, blue);
 }
 
 
 /// Texture Blending
 void Texture::setBlendMode(SDL_BlendMode blending) {
-    SDL_SetTextureBlendMode(texture.get(), blending);
+    blendMode = blending;
+    if(!atlased) SDL_SetTextureBlendMode(texture.get(), blending);
 }
 
 /// Transparency
@@ -147,7 +199,7 @@ void Texture::updateAlpha() {
 }
 
 void Texture::setAlpha(Uint8 alpha) {
-    SDL_SetTextureAlphaMod(texture.get(), alpha);
+    if(!atlased) SDL_SetTextureAlphaMod(texture.get(), alpha);
     textureAlpha = alpha;
 }
 
@@ -0,0 +1,121 @@
+// Implementation for texture atlases
+
+#include <algorithm>
+
+#include "utils/textureatlas.hpp"
+
+TextureAtlas::TextureAtlas() {}
+
+void TextureAtlas::build(const std::vector<Texture *> & textures, SDL_Renderer * renderer) {
+    int atlasSize = ATLAS_SIZE;
+
+    SDL_RendererInfo info;
+    if(SDL_GetRendererInfo(renderer, &info) == 0 && info.max_texture_width > 0) {
+        atlasSize = std::min({atlasSize, info.max_texture_width, info.max_texture_height});
+    }
+
+    // pack the tallest images first, in rows (shelves) left to right
+    std::vector<Texture *> packed;
+    for(Texture * texture: textures) {
+        SDL_Surface * surface = texture->getSurface();
+
+        if(enabled && surface && surface->w <= MAX_PACKED_SIZE && surface->h <= MAX_PACKED_SIZE) {
+            packed.push_back(texture);
+        } else {
+            texture->uploadSurface(renderer);
+        }
+    }
+
+    std::stable_sort(packed.begin(), packed.end(), [](Texture * a, Texture * b) {
+        return a->getSurface()->h > b->getSurface()->h;
+    });
+
+    // position of each packed image, and which atlas it's in
+    std::vector<SDL_Rect> regions(packed.size());
+    std::vector<int> atlasIndices(packed.size());
+    std::vector<std::pair<int, int>> atlasSizes;
+
+    int shelfX = 0, shelfY = 0, shelfHeight = 0;
+    atlasSizes.push_back({0, 0});
+
+    for(unsigned int i = 0; i < packed.size(); i++) {
+        SDL_Surface * surface = packed[i]->getSurface();
+
+        // next shelf/next atlas once full
+        if(shelfX + surface->w > atlasSize) {
+            shelfX = 0;
+            shelfY += shelfHeight + PADDING;
+            shelfHeight = 0;
+        }
+        if(shelfY + surface->h > atlasSize) {
+            atlasSizes.push_back({0, 0});
+            shelfX = 0;
+            shelfY = 0;
+            shelfHeight = 0;
+        }
+
+        regions[i] = {shelfX, shelfY, surface->w, surface->h};
+        atlasIndices[i] = atlasSizes.size() - 1;
+
+        auto & size = atlasSizes.back();
+        size.first = std::max(size.first, shelfX + surface->w);
+        size.second = std::max(size.second, shelfY + surface->h);
+
+        shelfX += surface->w + PADDING;
+        shelfHeight = std::max(shelfHeight, surface->h);
+    }
+
+    if(packed.empty()) return;
+
+    // copy the images into each atlas and upload it
+    for(unsigned int atlasIndex = 0; atlasIndex < atlasSizes.size(); atlasIndex++) {
+        SDL_Surface * atlasSurface = SDL_CreateRGBSurfaceWithFormat(0,
+            atlasSizes[atlasIndex].first, atlasSizes[atlasIndex].second, 32,
+            SDL_PIXELFORMAT_RGBA32);
+        if(!atlasSurface) {
+            printf("Error creating atlas surface, %s", SDL_GetError());
+            break;
+        }
+
+        for(unsigned int i = 0; i < packed.size(); i++) {
+            if(atlasIndices[i] != (int)atlasIndex) continue;
+
+            // copy pixels as is (color keyed pixels are skipped, leaving them
+            // transparent)
+            SDL_Surface * surface = packed[i]->getSurface();
+            SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(surface, NULL, atlasSurface, &regions[i]);
+        }
+
+        std::shared_ptr<SDL_Texture> atlas(SDL_CreateTextureFromSurface(renderer,
+            atlasSurface), SDL_DestroyTexture);
+        SDL_FreeSurface(atlasSurface);
+
+        if(!atlas.get()) {
+            printf("Error creating atlas texture, %s", SDL_GetError());
+            break;
+        }
+
+        SDL_SetTextureBlendMode(atlas.get(), SDL_BLENDMODE_BLEND);
+        atlases.push_back(atlas);
+
+        for(unsigned int i = 0; i < packed.size(); i++) {
+            if(atlasIndices[i] == (int)atlasIndex) {
+                packed[i]->setAtlasRegion(atlas, regions[i]);
+            }
+        }
+    }
+
+    // if an atlas couldn't be made, upload its images on their own
+    for(Texture * texture: packed) {
+        texture->uploadSurface(renderer);
+    }
+}
+
+int TextureAtlas::getAtlasCount() const {
+    return atlases.size();
+}
+
+void TextureAtlas::setEnabled(bool enabled) {
+    TextureAtlas::enabled = enabled;
+}
@@ -0,0 +1,65 @@
+// implementation for tile properties
+
+#include "utils/tileproperties.hpp"
+
+TileProperties::TileProperties() {}
+
+TileProperties::TileProperties(const tmx::Tileset & tileset) {
+    loadTileProperties(tileset);
+}
+
+void TileProperties::loadTileProperties(const tmx::Tileset & tileset) {
+    for(auto & tile: tileset.getTiles()) {
+        loadTileProperties(tile);
+    }
+}
+
+void TileProperties::loadTileProperties(const tmx::Tileset::Tile & tile) {
+    // check/store this tile's properties if nonempty
+    auto & properties = tile.properties;
+
+    if(!properties.empty()) {
+        std::map<std::string, std::any> propertyMap;
+
+        for(auto & property: properties) {
+            std::string propName = property.getName();
+            tmx::Property::Type type = property.getType();
+
+            switch(type) {
+                case tmx::Property::Type::Boolean:
+                    propertyMap.emplace(propName,
+                        std::any_cast<bool>(property.getBoolValue()));
+                    break;
+                case tmx::Property::Type::Float:
+                    propertyMap.emplace(propName,
+                        std::any_cast<float>(property.getFloatValue()));
+                    break;
+                case tmx::Property::Type::Int:
+                    propertyMap.emplace(propName,
+                        std::any_cast<int>(property.getIntValue()));
+                    break;
+                case tmx::Property::Type::String:
+                    propertyMap.emplace(propName,
+                        std::any_cast<std::string>(property.getStringValue()));
+                    break;
+                case tmx::Property::Type::Colour:
+                    propertyMap.emplace(propName,
+                        std::any_cast<tmx::Colour>(property.getColourValue()));
+                    break;
+                case tmx::Property::Type::File:
+                    propertyMap.emplace(propName,
+                        std::any_cast<std::string>(property.getFileValue()));
+                    break;
+                default:
+                    break;
+            }
+        }
+        tileProperties.emplace(tile.ID, propertyMap);
+    }
+}
+
+bool TileProperties::hasProperty(int tileID, std::string propertyName) const {
+    auto properties = tileProperties.find(tileID);
+    return properties != tileProperties.end() &&
+        properties->second.find(propertyName) != properties->second.end();
+}
@@ -0,0 +1,135 @@
+// Implementation for entity views
+
+#include "view/entityview.hpp"
+
+EntityView::EntityView(int screenX, int screenY, std::shared_ptr<Sprite> entitySprite,
+    const std::unordered_map<int, std::shared_ptr<Animation>> & entityAnimations,
+    int velocity) : entitySprite(entitySprite),
+    renderArea{screenX, screenY, entitySprite->getWidth(), entitySprite->getHeight()},
+    prevX(screenX), prevY(screenY), entityAnimations(&entityAnimations),
+    startX(screenX), startY(screenY),
+    endX(screenX), endY(screenY), velocity(velocity) {}
+
+void EntityView::update(float delta) {
+    prevX = renderArea.x;
+    prevY = renderArea.y;
+
+    if(moveProg < 1.f) {
+        // Update moveProg based on time;
+        moveProg += velocity * (delta/1000.f);
+
+        if(moveProg >= 1.f) {
+            moveProg = 1.f;
+            renderArea.x = endX;
+            renderArea.y = endY;
+        } else {
+            // Perform linear interpolation if not yet reached
+            std::pair<int, int> newPos = lerp(startX, startY, endX, endY, moveProg);
+            renderArea.x = newPos.first;
+            renderArea.y = newPos.second;
+        }
+    }
+
+    // update animation if needed
+    if(entityAnimator.isAnimating()) {
+        entityAnimator.update(delta);
+    }
+}
+
+void EntityView::render(SDL_Renderer * renderer, float alpha) const {
+    SDL_Rect area = renderArea;
+
+    if(alpha < 1.f && (prevX != renderArea.x || prevY != renderArea.y)) {
+        std::pair<int, int> pos = lerp(prevX, prevY, renderArea.x, renderArea.y, alpha);
+        area.x = pos.first;
+        area.y = pos.second;
+    }
+
+    if(entityAnimator.isAnimating()) {
+        entityAnimator.render(area.x, area.y, renderer, angle);
+    } else if(!hidden) {
+        entitySprite->render(renderer, area);
+    }
+}
+
+// Linear interpolation from current position to <endX, endY>
+std::pair<int,int> EntityView::lerp(int startX, int startY, int endX,
+    int endY, float t) {
+
+    float xChange = endX - startX;
+    float yChange = endY - startY;
+
+    int newX = startX + t * xChange;
+    int newY = startY + t * yChange;
+
+    return std::make_pair(newX, newY);
+}
+
+void EntityView::moveTo(int x, int y) {
+    startX = renderArea.x;
+    startY = renderArea.y;
+    endX = x;
+    endY = y;
+
+    moveProg = 0.f;
+}
+
+void EntityView::setPosition(int x, int y) {
+    renderArea.x = prevX = endX = x;
+    renderArea.y = prevY = endY = y;
+
+    moveProg = 1.f;
+}
+
+void EntityView::activateAnimation(int animationID, bool reverse) {
+    entityAnimator.setCurrAnimation(entityAnimations->at(animationID));
+    entityAnimator.start(reverse);
+}
+
+void EntityView::stopAnimator() {
+    entityAnimator.setAnimating(false);
+}
+
+void EntityView::setSprite(std::shared_ptr<Sprite> sprite) {
+    entitySprite = sprite;
+}
+
+void EntityView::setAngle(double angle) {
+    this->angle = angle;
+}
+
+void EntityView::setHidden(bool hidden) {
+    this->hidden = hidden;
+}
+
+int EntityView::getScreenX() const {
+    return renderArea.x;
+}
+
+int EntityView::getScreenY() const {
+    return renderArea.y;
+}
+
+int EntityView::getWidth() const {
+    return renderArea.w;
+}
+
+int EntityView::getHeight() const {
+    return renderArea.h;
+}
+
+float EntityView::getMoveProg() const {
+    return moveProg;
+}
+
+bool EntityView::isMoving() const {
+    return moveProg < 1.f;
+}
+
+bool EntityView::isAnimating() const {
+    return entityAnimator.isAnimating();
+}
+
+bool EntityView::isHidden() const {
+    return hidden;
+}
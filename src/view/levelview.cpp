@@ -0,0 +1,552 @@
+// Implementation for level view
+
+#include <algorithm>
+
+#include "memswap.hpp"
+
+#include "entities/player.hpp"
+#include "entities/diamond.hpp"
+#include "entities/boost.hpp"
+#include "entities/portal.hpp"
+
+#include "utils/profiler.hpp"
+#include "utils/renderstats.hpp"
+#include "utils/spritebatch.hpp"
+
+#include "view/levelview.hpp"
+
+LevelView::LevelView() {}
+
+// create tile/entity views for the given level
+void LevelView::build(const Level & level, MemSwap * game) {
+    PROFILE_ZONE("LevelView::build");
+
+    mGame = game;
+
+    const Map & map = level.getMap();
+    const ResManager & resManager = game->getResManager();
+
+    flipSound = resManager.getSoundHandle(FLIP_SOUND_ID);
+    bonkSound = resManager.getSoundHandle(BONK_SOUND_ID);
+    mergeSound = resManager.getSoundHandle(MERGE_SOUND_ID);
+    teleportSound = resManager.getSoundHandle(TELEPORT_SOUND_ID);
+
+    mapTiles.clear();
+    animatingTiles.clear();
+    parityTileSprites.clear();
+    entityViews.clear();
+    vanishAnimations.clear();
+    renderOrder.clear();
+    playerID = -1;
+
+    tileWidth = map.getTileWidth();
+    tileHeight = map.getTileHeight();
+    mapWidth = map.getWidth();
+    mapHeight = map.getHeight();
+
+    // the cached background is recreated if the map's size changed
+    if(backgroundTexture.get()) {
+        int width = 0, height = 0;
+        SDL_QueryTexture(backgroundTexture.get(), NULL, NULL, &width, &height);
+
+        if(width != mapWidth * tileWidth || height != mapHeight * tileHeight) {
+            backgroundTexture.reset();
+        }
+    }
+
+    // Compute where to start placing tiles, given map size (center the map)
+    renderX = (game->getScreenWidth() / 2) - (mapWidth * tileWidth / 2);
+    renderY = (game->getScreenHeight() / 2) - (map.getHeight() * tileHeight / 2);
+
+    // Iterate through each tile (top left corner -> down right)
+    for(int y = 0; y < map.getHeight(); y++) {
+        for(int x = 0; x < mapWidth; x++) {
+            int tileGID = map.getTileGID(x, y);
+            int tilesetFirstGID = map.getTilesetFirstGID(tileGID);
+
+            // no tileset found
+            if(tilesetFirstGID == -1) continue;
+
+            auto tileSprite = resManager.getSpriteSheet(
+                map.getTilesetName(tilesetFirstGID))->getSprite(tileGID - tilesetFirstGID);
+
+            // add to parityTileSprites if not yet complete
+            if(parityTileSprites.size() < 2) {
+                parityTileSprites.emplace(map.getTileParity(x, y), tileSprite);
+            }
+
+            mapTiles.emplace_back(toScreenX(x), toScreenY(y), tileSprite,
+                resManager.getTileAnimations());
+        }
+    }
+
+    // create views for each entity, movables rendered on top
+    std::vector<int> movableViews;
+
+    for(auto & entity: map.getEntities()) {
+        int entityID = entity->getEntityID();
+        int tileGID = map.getEntityGID(entityID);
+        int tilesetFirstGID = map.getTilesetFirstGID(tileGID);
+
+        auto entitySprite = resManager.getSpriteSheet(
+            map.getTilesetName(tilesetFirstGID))->getSprite(tileGID - tilesetFirstGID);
+
+        const std::unordered_map<int, std::shared_ptr<Animation>> * animations =
+            &resManager.getReceptorAnimations();
+        int velocity = 0;
+        int vanishAnimation = -1;
+        double angle = 0.0;
+
+        if(entity->getKind() == ENTITY_PLAYER) {
+            animations = &resManager.getPlayerAnimations();
+            velocity = PLAYER_VELOCITY;
+            vanishAnimation = PLAYER_MERGE;
+            playerID = entityID;
+        } else if(entity->getKind() == ENTITY_DIAMOND) {
+            animations = &resManager.getDiamondAnimations();
+            velocity = DIAMOND_VELOCITY;
+            vanishAnimation = DIAMOND_MERGE;
+        } else if(entity->getKind() == ENTITY_BOOST) {
+            auto boost = std::static_pointer_cast<Boost>(entity);
+            animations = &resManager.getBoostAnimations();
+            vanishAnimation = boost->getPower() == 1 ? BOOST_VANISH1 : BOOST_VANISH2;
+
+            // vanish animation faces the boost's direction
+            switch(boost->getDirection()) {
+                case DIR_LEFT:      angle = 180.0;
+                                    break;
+                case DIR_RIGHT:     angle = 0.0;
+                                    break;
+                case DIR_UP:        angle = 270.0;
+                                    break;
+                case DIR_DOWN:      angle = 90.0;
+                                    break;
+                default:            break;
+            }
+        } else if(entity->getKind() == ENTITY_PORTAL) {
+            animations = &resManager.getPortalAnimations();
+            vanishAnimation = PORTAL_MERGE;
+        }
+
+        entityViews.emplace_back(toScreenX(entity->getGridX()), toScreenY(entity->getGridY()),
+            entitySprite, *animations, velocity);
+        entityViews.back().setAngle(angle);
+        vanishAnimations.push_back(vanishAnimation);
+
+        if(velocity > 0) {
+            movableViews.push_back(entityID);
+        } else {
+            renderOrder.push_back(entityID);
+        }
+    }
+
+    renderOrder.insert(renderOrder.end(), movableViews.begin(), movableViews.end());
+
+    // size the per-move lists for the whole map up front, so playing moves
+    // back doesn't allocate (past that many dirty tiles, the background is
+    // redrawn whole anyway)
+    animatingTiles.reserve(mapTiles.size());
+    dirtyTiles.reserve(mapTiles.size() + 1);
+    activeBoosts.reserve(entityViews.size());
+
+    sync(level);
+}
+
+// snap all views to the current state of the level
+void LevelView::sync(const Level & level) {
+    PROFILE_ZONE("LevelView::sync");
+
+    const Map & map = level.getMap();
+
+    pendingEvents.clear();
+    currEvent = 0;
+    blockingView = -1;
+    teleporting = false;
+    activeBoosts.clear();
+    bufferedInput = INPUT_NONE;
+    showingHint = false;
+
+    // every tile may have changed, redraw the whole background
+    backgroundValid = false;
+    dirtyTiles.clear();
+
+    for(unsigned int i = 0; i < mapTiles.size(); i++) {
+        auto coords = map.indexToXY(i);
+        auto paritySprite = parityTileSprites.find(map.getTileParity(coords.first, coords.second));
+
+        if(paritySprite != parityTileSprites.end()) {
+            mapTiles[i].setSprite(paritySprite->second);
+        }
+    }
+
+    auto & entities = map.getEntities();
+    for(unsigned int i = 0; i < entityViews.size(); i++) {
+        EntityView & view = entityViews[i];
+
+        view.stopAnimator();
+        view.setPosition(toScreenX(entities[i]->getGridX()), toScreenY(entities[i]->getGridY()));
+        view.setHidden(entities[i]->isVanished());
+    }
+}
+
+void LevelView::handleEvents(Level & level, const Uint8 * keyStates) {
+    // check for move undo ('u')
+    if(keyStates[SDL_SCANCODE_U]) {
+        if(undoBuffer == 0) {
+            undoBuffer = UNDO_BUFFER_CAP;
+            level.step(INPUT_UNDO);
+            sync(level);
+        }
+        return;
+    }
+
+    SimInput input = INPUT_NONE;
+
+    // Check for key inputs
+    if(keyStates[SDL_SCANCODE_W]) {
+        input = INPUT_UP;
+    } else if (keyStates[SDL_SCANCODE_S]) {
+        input = INPUT_DOWN;
+    } else if (keyStates[SDL_SCANCODE_A]) {
+        input = INPUT_LEFT;
+    } else if (keyStates[SDL_SCANCODE_D]) {
+        input = INPUT_RIGHT;
+    }
+
+    if(!isAnimating()) {
+        // play any buffered move first
+        if(bufferedInput != INPUT_NONE) {
+            input = bufferedInput;
+            bufferedInput = INPUT_NONE;
+        }
+
+        if(input != INPUT_NONE) stepLevel(level, input);
+    } else if(input != INPUT_NONE && bufferedInput == INPUT_NONE &&
+        currEvent >= pendingEvents.size() && blockingView == playerID &&
+        entityViews.at(playerID).getMoveProg() > MOVEMENT_BUFFER) {
+        // buffer a move when the player's last move is nearly finished
+        bufferedInput = input;
+    }
+}
+
+void LevelView::stepLevel(Level & level, SimInput input) {
+    level.step(input);
+
+    auto & events = level.getEvents();
+    pendingEvents.assign(events.begin(), events.end());
+    currEvent = 0;
+}
+
+void LevelView::update(float delta) {
+    PROFILE_ZONE("LevelView::update");
+
+    if(undoBuffer > 0) undoBuffer--;
+
+    // only animating tiles change, redrawn into the background once done
+    for(auto tile = animatingTiles.begin(); tile != animatingTiles.end();) {
+        mapTiles[*tile].update(delta);
+
+        if(!mapTiles[*tile].isAnimating()) {
+            dirtyTiles.push_back(*tile);
+            tile = animatingTiles.erase(tile);
+        } else {
+            tile++;
+        }
+    }
+
+    for(EntityView & view: entityViews) {
+        view.update(delta);
+    }
+
+    // play back events until one has to be waited on
+    while(!waitingOnView() && currEvent < pendingEvents.size()) {
+        playEvent(pendingEvents[currEvent++]);
+    }
+}
+
+// play back a single simulation event
+void LevelView::playEvent(const SimEvent & event) {
+    switch(event.type) {
+        case EVENT_MOVE: {
+            vanishBoosts(event.x, event.y);
+
+            entityViews.at(event.entityID).moveTo(toScreenX(event.toX), toScreenY(event.toY));
+            blockingView = event.entityID;
+            break;
+        }
+        case EVENT_FLIP: {
+            flipTile(event.x + event.y * mapWidth, parityTileSprites.at(event.value));
+            mGame->playSound(flipSound);
+            break;
+        }
+        case EVENT_BOOST: {
+            // bumped boosts vanish right away, others once moved off of
+            if(event.x != event.toX || event.y != event.toY) {
+                EntityView & view = entityViews.at(event.otherID);
+                view.activateAnimation(vanishAnimations.at(event.otherID));
+                view.setHidden(true);
+            } else {
+                activeBoosts.push_back(event.otherID);
+            }
+            break;
+        }
+        case EVENT_MERGE: {
+            entityViews.at(event.otherID).setHidden(true);
+
+            EntityView & view = entityViews.at(event.entityID);
+            view.activateAnimation(vanishAnimations.at(event.entityID));
+            view.setHidden(true);
+            blockingView = event.entityID;
+
+            if(event.entityID != playerID) mGame->playSound(mergeSound);
+            break;
+        }
+        case EVENT_TELEPORT: {
+            // activate player teleport-in animation, teleporting out once finished
+            EntityView & view = entityViews.at(event.entityID);
+            view.activateAnimation(PLAYER_TELEPORT);
+            view.setHidden(true);
+            mGame->playSound(teleportSound);
+
+            teleporting = true;
+            teleportX = toScreenX(event.toX);
+            teleportY = toScreenY(event.toY);
+            blockingView = event.entityID;
+            break;
+        }
+        case EVENT_VANISH: {
+            EntityView & view = entityViews.at(event.entityID);
+            view.activateAnimation(vanishAnimations.at(event.entityID));
+            view.setHidden(true);
+            break;
+        }
+        case EVENT_BONK: {
+            EntityView & view = entityViews.at(event.entityID);
+
+            if(!view.isAnimating()) {
+                switch(event.value) {
+                    case DIR_LEFT:  view.activateAnimation(PLAYER_MOVEFAIL_LEFT);
+                                    break;
+                    case DIR_RIGHT: view.activateAnimation(PLAYER_MOVEFAIL_RIGHT);
+                                    break;
+                    case DIR_UP:    view.activateAnimation(PLAYER_MOVEFAIL_UP);
+                                    break;
+                    case DIR_DOWN:  view.activateAnimation(PLAYER_MOVEFAIL_DOWN);
+                                    break;
+                    default:        break;
+                }
+
+                mGame->playSound(bonkSound);
+            }
+            break;
+        }
+        case EVENT_COMPLETE:
+            break;
+    }
+}
+
+// check if playback has to wait for the movement/animation of a view
+bool LevelView::waitingOnView() {
+    if(blockingView == -1) return false;
+
+    EntityView & view = entityViews.at(blockingView);
+    if(view.isMoving() || view.isAnimating()) return true;
+
+    // once the teleport-in animation finishes, teleport out of the other portal
+    if(teleporting) {
+        teleporting = false;
+
+        view.setPosition(teleportX, teleportY);
+        view.setHidden(false);
+        view.activateAnimation(PLAYER_TELEPORT, true);
+        return true;
+    }
+
+    blockingView = -1;
+    return false;
+}
+
+// vanish boosts once their rider moves off of them
+void LevelView::vanishBoosts(int gridX, int gridY) {
+    for(auto boost = activeBoosts.begin(); boost != activeBoosts.end(); boost++) {
+        EntityView & view = entityViews.at(*boost);
+
+        if(view.getScreenX() == toScreenX(gridX) && view.getScreenY() == toScreenY(gridY)) {
+            view.activateAnimation(vanishAnimations.at(*boost));
+            view.setHidden(true);
+
+            activeBoosts.erase(boost);
+            return;
+        }
+    }
+}
+
+void LevelView::flipTile(int index, std::shared_ptr<Sprite> sprite) {
+    mapTiles.at(index).flip(sprite, false);
+
+    if(std::find(animatingTiles.begin(), animatingTiles.end(), index) == animatingTiles.end()) {
+        animatingTiles.push_back(index);
+    }
+
+    dirtyTiles.push_back(index);
+}
+
+bool LevelView::renderBackground(SDL_Renderer * renderer) const {
+    PROFILE_ZONE("LevelView::renderBackground");
+
+    int width = mapWidth * tileWidth, height = mapHeight * tileHeight;
+
+    if(!backgroundTexture.get()) {
+        if(!SDL_RenderTargetSupported(renderer)) return false;
+
+        backgroundTexture = std::shared_ptr<SDL_Texture>(SDL_CreateTexture(renderer,
+            SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height),
+            SDL_DestroyTexture);
+        if(!backgroundTexture.get()) return false;
+
+        backgroundValid = false;
+    }
+
+    // the target's contents were lost
+    if(renderResets != mGame->getRenderResets()) {
+        renderResets = mGame->getRenderResets();
+        backgroundValid = false;
+    }
+
+    // draws made so far (batched) go to the screen
+    SpriteBatch::flush();
+
+    // too many changes to be worth tracking one by one
+    if(dirtyTiles.size() > mapTiles.size()) backgroundValid = false;
+
+    if(!backgroundValid || !dirtyTiles.empty()) {
+        SDL_Texture * screen = SDL_GetRenderTarget(renderer);
+        SDL_SetRenderTarget(renderer, backgroundTexture.get());
+
+        SDL_Color drawColor;
+        SDL_GetRenderDrawColor(renderer, &drawColor.r, &drawColor.g, &drawColor.b, &drawColor.a);
+
+        // tiles are drawn over black, as they would be on the (cleared) screen,
+        // animating tiles are left black
+        SDL_SetRenderDrawColor(renderer, 0x00, 0x00, 0x00, 0xFF);
+
+        if(!backgroundValid) {
+            SDL_RenderClear(renderer);
+
+            for(unsigned int i = 0; i < mapTiles.size(); i++) {
+                if(!mapTiles[i].isAnimating()) {
+                    mapTiles[i].renderSprite(renderer, (i % mapWidth) * tileWidth,
+                        (i / mapWidth) * tileHeight);
+                }
+            }
+        } else {
+            for(int i: dirtyTiles) {
+                SDL_Rect tileArea = {(i % mapWidth) * tileWidth, (i / mapWidth) * tileHeight,
+                    tileWidth, tileHeight};
+                SDL_RenderFillRect(renderer, &tileArea);
+
+                if(!mapTiles[i].isAnimating()) {
+                    mapTiles[i].renderSprite(renderer, tileArea.x, tileArea.y);
+                }
+            }
+        }
+
+        SpriteBatch::flush();
+        SDL_SetRenderTarget(renderer, screen);
+        SDL_SetRenderDrawColor(renderer, drawColor.r, drawColor.g, drawColor.b, drawColor.a);
+
+        backgroundValid = true;
+        dirtyTiles.clear();
+    }
+
+    SDL_Rect renderArea = {renderX, renderY, width, height};
+    RenderStats::countDraw(backgroundTexture.get());
+    SDL_RenderCopy(renderer, backgroundTexture.get(), NULL, &renderArea);
+
+    return true;
+}
+
+void LevelView::render(SDL_Renderer * renderer) const {
+    PROFILE_ZONE("LevelView::render");
+
+    // Render the background tiles, from the cache if possible (animating
+    // tiles drawn on top)
+    if(renderBackground(renderer)) {
+        for(int tile: animatingTiles) {
+            mapTiles[tile].render(renderer);
+        }
+    } else {
+        for(const Tile & tile: mapTiles) {
+            tile.render(renderer);
+        }
+    }
+
+    // Render the entities (between their positions at the last two ticks)
+    float tickAlpha = mGame->getTickAlpha();
+    for(int entityID: renderOrder) {
+        entityViews[entityID].render(renderer, tickAlpha);
+    }
+
+    if(showingHint) {
+        SpriteBatch::flush();
+
+        SDL_Color color = mGame->getOutlineColor();
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+
+        for(int i = 0; i < HINT_OUTLINE; i++) {
+            SDL_Rect outline = {hintRect.x + i, hintRect.y + i, hintRect.w - 2 * i,
+                hintRect.h - 2 * i};
+            SDL_RenderDrawRect(renderer, &outline);
+        }
+    }
+}
+
+void LevelView::showHint(const Level & level, SimInput move) {
+    Player * player = level.getPlayer();
+    showingHint = player && move != INPUT_NONE;
+    if(!showingHint) return;
+
+    int gridX = player->getGridX(), gridY = player->getGridY();
+    switch(move) {
+        case INPUT_UP:      gridY--;
+                            break;
+        case INPUT_DOWN:    gridY++;
+                            break;
+        case INPUT_LEFT:    gridX--;
+                            break;
+        case INPUT_RIGHT:   gridX++;
+                            break;
+        default:            break;
+    }
+
+    hintRect = {toScreenX(gridX), toScreenY(gridY), tileWidth, tileHeight};
+}
+
+void LevelView::clearHint() {
+    showingHint = false;
+}
+
+bool LevelView::isAnimating() const {
+    return currEvent < pendingEvents.size() || blockingView != -1;
+}
+
+bool LevelView::isIdle() const {
+    if(isAnimating() || !animatingTiles.empty() || undoBuffer > 0 ||
+        bufferedInput != INPUT_NONE) {
+        return false;
+    }
+
+    for(const EntityView & view: entityViews) {
+        if(view.isMoving() || view.isAnimating()) return false;
+    }
+
+    return true;
+}
+
+int LevelView::toScreenX(int gridX) const {
+    return renderX + gridX * tileWidth;
+}
+
+int LevelView::toScreenY(int gridY) const {
+    return renderY + gridY * tileHeight;
+}
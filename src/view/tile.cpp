@@ -0,0 +1,27 @@
+// Implementation for tile class
+
+#include "view/tile.hpp"
+
+Tile::Tile(int screenX, int screenY, std::shared_ptr<Sprite> tileSprite,
+    const std::unordered_map<int, std::shared_ptr<Animation>> & entityAnimations)
+    : EntityView(screenX, screenY, tileSprite, entityAnimations) {}
+
+// Filp tile's parity, + update sprite
+void Tile::flip(std::shared_ptr<Sprite> newTileSprite, bool undo) {
+    entitySprite.reset();
+    entitySprite = newTileSprite;
+    flipped = true;
+
+    // flipping animation if not undo
+    if(!undo) {
+        activateAnimation(TILE_FLIP);
+    }
+}
+
+void Tile::renderSprite(SDL_Renderer * renderer, int x, int y) const {
+    entitySprite->render(renderer, {x, y, renderArea.w, renderArea.h});
+}
+
+bool Tile::isFlipped() const {
+    return flipped;
+}
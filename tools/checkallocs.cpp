@@ -0,0 +1,97 @@
+// Check that stepping a level doesn't allocate once warmed up
+//
+// Drives each level headlessly with a fixed pseudo-random stream of inputs
+// (moves, undos and the odd reset) for a number of ticks, counting heap
+// allocations (see utils/allocstats.hpp) after a warm-up, in which the undo
+// log/event lists grow to size. Exits with 1 if any level allocated after
+// warming up.
+//
+// usage: checkallocs [-t ticks] [-w warm-up ticks] [maps directory | maps...]
+//        (default: 20000 ticks after 2000 warm-up ticks, res/maps)
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "level/level.hpp"
+#include "utils/allocstats.hpp"
+
+namespace fs = std::filesystem;
+
+// one reset every RESET_TICKS ticks on average, and undo 1 in UNDO_ODDS moves
+const int RESET_TICKS = 500;
+const int UNDO_ODDS = 6;
+
+// step the level through the given number of ticks of input
+void drive(Level & level, std::mt19937 & rng, int ticks) {
+    const SimInput MOVES[] = {INPUT_UP, INPUT_DOWN, INPUT_LEFT, INPUT_RIGHT};
+
+    for(int tick = 0; tick < ticks; tick++) {
+        if(rng() % RESET_TICKS == 0) {
+            level.step(INPUT_RESET);
+        } else if(rng() % UNDO_ODDS == 0) {
+            level.step(INPUT_UNDO);
+        } else {
+            level.step(MOVES[rng() % 4]);
+        }
+    }
+}
+
+int main(int argc, char * argv[]) {
+    int ticks = 20000;
+    int warmUpTicks = 2000;
+    std::vector<std::string> mapPaths;
+
+    for(int i = 1; i < argc; i++) {
+        if(std::strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            ticks = std::atoi(argv[++i]);
+        } else if(std::strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            warmUpTicks = std::atoi(argv[++i]);
+        } else if(fs::is_directory(argv[i])) {
+            for(auto & entry: fs::directory_iterator(argv[i])) {
+                if(entry.path().extension() == ".tmx") {
+                    mapPaths.push_back(entry.path().string());
+                }
+            }
+        } else {
+            mapPaths.push_back(argv[i]);
+        }
+    }
+
+    if(mapPaths.empty()) {
+        for(auto & entry: fs::directory_iterator("res/maps")) {
+            if(entry.path().extension() == ".tmx") {
+                mapPaths.push_back(entry.path().string());
+            }
+        }
+    }
+    std::sort(mapPaths.begin(), mapPaths.end());
+
+    printf("%-16s %10s %12s %12s\n", "map", "ticks", "allocations", "per tick");
+
+    int failed = 0;
+
+    for(auto & mapPath: mapPaths) {
+        Level level(mapPath);
+        std::mt19937 rng(1);
+
+        drive(level, rng, warmUpTicks);
+
+        long long allocations = AllocStats::getAllocations();
+        drive(level, rng, ticks);
+        allocations = AllocStats::getAllocations() - allocations;
+
+        if(allocations) failed++;
+
+        printf("%-16s %10d %12lld %12.4f%s\n", fs::path(mapPath).filename().string().c_str(),
+            ticks, allocations, (double)allocations / ticks, allocations ? "  FAIL" : "");
+    }
+
+    printf("%zu maps, %d allocated after warming up\n", mapPaths.size(), failed);
+    return failed ? 1 : 0;
+}
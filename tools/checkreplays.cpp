@@ -0,0 +1,87 @@
+// Check that recorded replays still play back to the same result
+//
+// Steps each replay's level (loaded from the maps directory) through its
+// recorded simulation inputs and compares the final state's hash with the
+// recorded one, so a change to the simulation that alters how a recorded
+// play turns out is caught without playing it back in game. Exits with 1 if
+// any replay diverges or can't be loaded.
+//
+// usage: checkreplays <replays directory | replays...> [-m maps directory]
+//        -m loads levels from the given directory (default: res/maps)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "level/level.hpp"
+#include "level/replay.hpp"
+
+namespace fs = std::filesystem;
+
+int main(int argc, char * argv[]) {
+    std::string mapsDir = "res/maps";
+    std::vector<std::string> replayPaths;
+
+    for(int i = 1; i < argc; i++) {
+        if(std::strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            mapsDir = argv[++i];
+        } else if(fs::is_directory(argv[i])) {
+            for(auto & entry: fs::directory_iterator(argv[i])) {
+                if(entry.path().extension() == ".rpl") {
+                    replayPaths.push_back(entry.path().string());
+                }
+            }
+        } else {
+            replayPaths.push_back(argv[i]);
+        }
+    }
+
+    if(replayPaths.empty()) {
+        printf("usage: checkreplays <replays directory | replays...> [-m maps directory]\n");
+        return 1;
+    }
+    std::sort(replayPaths.begin(), replayPaths.end());
+
+    printf("%-24s %-16s %-9s %8s %8s %10s\n", "replay", "level", "result", "ticks",
+        "inputs", "ms");
+
+    int failed = 0;
+
+    for(auto & replayPath: replayPaths) {
+        std::string name = fs::path(replayPath).filename().string();
+
+        Replay replay;
+        if(!replay.load(replayPath)) {
+            failed++;
+            continue;
+        }
+
+        std::string mapPath = mapsDir + "/" + replay.getLevelID() + ".tmx";
+        if(!fs::exists(mapPath)) {
+            printf("%-24s %-16s %-9s\n", name.c_str(), replay.getLevelID().c_str(), "no map");
+            failed++;
+            continue;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        Level level(mapPath);
+        bool matches = replay.verify(level);
+
+        double ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+
+        if(!matches) failed++;
+
+        printf("%-24s %-16s %-9s %8u %8zu %10.2f\n", name.c_str(),
+            replay.getLevelID().c_str(), matches ? "ok" : "diverged",
+            replay.getTickCount(), replay.getSteps().size(), ms);
+    }
+
+    printf("%zu replays, %d failed\n", replayPaths.size(), failed);
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,126 @@
+// Compile tiledmaps to the binary level format loaded by the game
+//
+// Loads each map (every .tmx in the given directory, or the given .tmx files)
+// with its tilesets, and writes the result next to it as a .lvl file (see
+// level/levelfile.hpp). Each compiled level is loaded back and checked against
+// the tiledmap. Exits with 1 if any map failed to compile.
+//
+// usage: compilemaps [maps directory | maps...]
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "level/level.hpp"
+
+namespace fs = std::filesystem;
+
+// if two loaded maps are the same (state, tile GIDs, tilesets and entities)
+bool sameMap(const Map & a, const Map & b) {
+    if(a.getWidth() != b.getWidth() || a.getHeight() != b.getHeight() ||
+        a.getTileWidth() != b.getTileWidth() || a.getTileHeight() != b.getTileHeight() ||
+        a.getHash() != b.getHash() || a.hasPortals() != b.hasPortals() ||
+        a.getTileParities() != b.getTileParities() ||
+        a.getEntities().size() != b.getEntities().size()) {
+        return false;
+    }
+
+    // maps without a background layer have no tile GIDs
+    if(a.getTileParities().getSize() > 0) {
+        for(int y = 0; y < a.getHeight(); y++) {
+            for(int x = 0; x < a.getWidth(); x++) {
+                int gid = a.getTileGID(x, y);
+                if(gid != b.getTileGID(x, y) ||
+                    a.getTilesetFirstGID(gid) != b.getTilesetFirstGID(gid)) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    for(unsigned int i = 0; i < a.getEntities().size(); i++) {
+        auto & entityA = a.getEntities()[i];
+        auto & entityB = b.getEntities()[i];
+        int gid = a.getEntityGID(i);
+
+        if(entityA->getKind() != entityB->getKind() ||
+            entityA->getGridX() != entityB->getGridX() ||
+            entityA->getGridY() != entityB->getGridY() ||
+            entityA->getParity() != entityB->getParity() ||
+            gid != b.getEntityGID(i) ||
+            a.getTilesetName(a.getTilesetFirstGID(gid)) !=
+                b.getTilesetName(b.getTilesetFirstGID(gid))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+int main(int argc, char * argv[]) {
+    std::vector<std::string> mapPaths;
+
+    for(int i = 1; i < argc; i++) {
+        if(fs::is_directory(argv[i])) {
+            for(auto & entry: fs::directory_iterator(argv[i])) {
+                if(entry.path().extension() == ".tmx") {
+                    mapPaths.push_back(entry.path().string());
+                }
+            }
+        } else {
+            mapPaths.push_back(argv[i]);
+        }
+    }
+
+    if(mapPaths.empty()) {
+        for(auto & entry: fs::directory_iterator("res/maps")) {
+            if(entry.path().extension() == ".tmx") {
+                mapPaths.push_back(entry.path().string());
+            }
+        }
+    }
+    std::sort(mapPaths.begin(), mapPaths.end());
+
+    printf("%-16s %-8s %9s %7s %10s %10s\n", "map", "result", "size", "ents",
+        "tmx bytes", "lvl bytes");
+
+    int failed = 0;
+
+    for(auto & mapPath: mapPaths) {
+        std::string compiledPath = fs::path(mapPath).replace_extension(".lvl").string();
+
+        Level level(mapPath);
+        const Map & map = level.getMap();
+
+        const char * status = "ok";
+        if(!map.saveCompiledMap(compiledPath)) {
+            status = "failed";
+        } else {
+            // load it directly (a level would fall back to the tiledmap)
+            Level owner;
+            Map compiled;
+            if(!compiled.loadCompiledMap(compiledPath, &owner) || !sameMap(map, compiled)) {
+                status = "mismatch";
+            }
+        }
+
+        if(status[0] != 'o') {
+            failed++;
+            fs::remove(compiledPath);
+        }
+
+        std::error_code error;
+        uintmax_t compiledSize = fs::file_size(compiledPath, error);
+
+        printf("%-16s %-8s %4dx%-4d %7zu %10ju %10ju\n",
+            fs::path(mapPath).filename().string().c_str(), status,
+            map.getWidth(), map.getHeight(), map.getEntities().size(),
+            fs::file_size(mapPath), error ? 0 : compiledSize);
+    }
+
+    printf("%zu maps, %d failed\n", mapPaths.size(), failed);
+
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,117 @@
+// Generate the compile time resource IDs from res_paths.json
+//
+// Writes a header (see utils/resid.hpp) with a ResId constant for each
+// resource listed, named RES_<ID> (camelCase split into words, upper case,
+// anything else turned into _), and a static_assert that none of their hashes
+// collide, so a collision fails the build. Exits with 1 (without writing) if
+// two IDs would have the same name or hash.
+//
+// usage: genresids [res_paths.json] [header]
+//        (default: res/res_paths.json include/utils/resids.hpp)
+
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "utils/resid.hpp"
+
+using json = nlohmann::json;
+
+// eg. "playerMoveFailUp" -> "RES_PLAYER_MOVE_FAIL_UP", "1-X" -> "RES_1_X"
+std::string constantName(const std::string & id) {
+    std::string name = "RES_";
+
+    for(unsigned int i = 0; i < id.size(); i++) {
+        char c = id[i];
+
+        if(std::isupper((unsigned char)c) && i > 0 && std::islower((unsigned char)id[i - 1])) {
+            name += '_';
+        }
+
+        name += std::isalnum((unsigned char)c) ? (char)std::toupper((unsigned char)c) : '_';
+    }
+
+    return name;
+}
+
+int main(int argc, char * argv[]) {
+    std::string resPathsFile = argc > 1 ? argv[1] : "res/res_paths.json";
+    std::string headerFile = argc > 2 ? argv[2] : "include/utils/resids.hpp";
+
+    std::ifstream resPaths(resPathsFile);
+    json resJson = json::parse(resPaths, nullptr, false);
+
+    if(resJson.is_discarded() || !resJson.is_object()) {
+        printf("Error loading %s\n", resPathsFile.c_str());
+        return 1;
+    }
+
+    std::ostringstream header;
+    header << "// Resource IDs, from res/res_paths.json\n"
+        "//\n"
+        "// Generated by tools/genresids (make resids), don't edit by hand.\n\n"
+        "#ifndef RESIDS_HPP\n"
+        "#define RESIDS_HPP\n\n"
+        "#include \"utils/resid.hpp\"\n";
+
+    std::map<std::string, std::string> names;
+    std::map<uint64_t, std::string> hashes;
+    std::vector<std::string> constants;
+    bool failed = false;
+
+    for(auto & resType: resJson.items()) {
+        header << "\n// " << resType.key() << "\n";
+
+        for(auto & res: resType.value().items()) {
+            const std::string & id = res.key();
+            std::string name = constantName(id);
+            uint64_t hash = ResId::hashID(id.c_str(), id.size());
+
+            if(names.count(name)) {
+                printf("Resource IDs %s and %s are both named %s\n", names[name].c_str(),
+                    id.c_str(), name.c_str());
+                failed = true;
+            }
+
+            if(hashes.count(hash)) {
+                printf("Resource IDs %s and %s have the same hash\n", hashes[hash].c_str(),
+                    id.c_str());
+                failed = true;
+            }
+
+            names[name] = id;
+            hashes[hash] = id;
+            constants.push_back(name);
+
+            header << "inline constexpr ResId " << name << " = \"" << id << "\";\n";
+        }
+    }
+
+    if(failed) return 1;
+
+    header << "\n// every ID above, checked for hash collisions\n"
+        "inline constexpr ResId ALL_RES_IDS[] = {\n";
+    for(unsigned int i = 0; i < constants.size(); i++) {
+        header << "    " << constants[i] << (i + 1 < constants.size() ? ",\n" : "\n");
+    }
+    header << "};\n\n"
+        "static_assert(resIdsUnique(ALL_RES_IDS), \"resource ID hash collision, rename one\");\n\n"
+        "#endif // RESIDS_HPP\n";
+
+    std::ofstream out(headerFile);
+    out << header.str();
+
+    if(!out.good()) {
+        printf("Error writing %s\n", headerFile.c_str());
+        return 1;
+    }
+
+    printf("%zu resource IDs written to %s\n", constants.size(), headerFile.c_str());
+    return 0;
+}
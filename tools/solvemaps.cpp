@@ -0,0 +1,189 @@
+// Certify that levels are solvable, reporting their optimal move counts
+//
+// Runs the solver on each map (every .tmx in the given directory, or the
+// given .tmx files) and prints a table of the results. Exits with 1 if any
+// map couldn't be solved (maps without a player are reported as empty).
+// Solutions can be written as replays (see level/replay.hpp), which hold
+// each move's key for a tick and then wait out its animations in game.
+//
+// usage: solvemaps [-m memory cap in MB] [-t threads] [-s] [-v]
+//                  [-r replays directory] [maps directory | maps...]
+//        -t searches on the given number of threads (default: all cores)
+//        -s solves each map on 1 to the given number of threads, and
+//           reports the scaling efficiency
+//        -v prints each solution (U/D/L/R)
+//        -r writes each solution to <replays directory>/<map name>.rpl
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "entities/player.hpp"
+#include "level/replay.hpp"
+#include "solver/solver.hpp"
+
+namespace fs = std::filesystem;
+
+// ticks (at 60 per second) the level view takes to play back each event,
+// with its velocities and animations (see view/levelview.hpp)
+const int PLAYER_MOVE_TICKS = 10;
+const int DIAMOND_MOVE_TICKS = 20;
+const int TELEPORT_TICKS = 30;
+const int MERGE_TICKS = 20;
+
+// ticks to wait on top of a move's events, and before the first/after the
+// last move (the level fades in/out)
+const int SETTLE_TICKS = 6;
+const int FADE_TICKS = 60;
+
+uint8_t replayKey(SimInput input) {
+    switch(input) {
+        case INPUT_UP:      return REPLAY_KEY_UP;
+        case INPUT_DOWN:    return REPLAY_KEY_DOWN;
+        case INPUT_LEFT:    return REPLAY_KEY_LEFT;
+        case INPUT_RIGHT:   return REPLAY_KEY_RIGHT;
+        default:            return 0;
+    }
+}
+
+// record the solution as a replay of the map, named after it
+bool saveReplay(const std::string & mapPath, const std::vector<SimInput> & moves,
+    const std::string & replaysDir) {
+
+    std::string levelID = fs::path(mapPath).stem().string();
+    Level level(mapPath);
+    Replay replay(levelID);
+    int playerID = level.getPlayer()->getEntityID();
+
+    level.setRecorder(&replay);
+    for(int i = 0; i < FADE_TICKS; i++) replay.recordTick(0);
+
+    for(SimInput input: moves) {
+        replay.recordTick(replayKey(input));
+        level.step(input);
+
+        int ticks = SETTLE_TICKS;
+        for(auto & event: level.getEvents()) {
+            switch(event.type) {
+                case EVENT_MOVE:
+                    ticks += event.entityID == playerID ? PLAYER_MOVE_TICKS : DIAMOND_MOVE_TICKS;
+                    break;
+                case EVENT_TELEPORT:
+                    ticks += TELEPORT_TICKS;
+                    break;
+                case EVENT_MERGE:
+                    ticks += MERGE_TICKS;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        for(int i = 0; i < ticks; i++) replay.recordTick(0);
+    }
+
+    for(int i = 0; i < FADE_TICKS; i++) replay.recordTick(0);
+    level.setRecorder(nullptr);
+    replay.finish(level.getHash());
+
+    return replay.save((fs::path(replaysDir) / (levelID + ".rpl")).string());
+}
+
+int main(int argc, char * argv[]) {
+    size_t memoryCap = Solver::DEFAULT_MEMORY_CAP;
+    int threads = std::max((int)std::thread::hardware_concurrency(), 1);
+    bool scaling = false;
+    bool verbose = false;
+    std::string replaysDir;
+    std::vector<std::string> mapPaths;
+
+    for(int i = 1; i < argc; i++) {
+        if(std::strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+            memoryCap = (size_t)std::atoll(argv[++i]) << 20;
+        } else if(std::strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            threads = std::max(std::atoi(argv[++i]), 1);
+        } else if(std::strcmp(argv[i], "-s") == 0) {
+            scaling = true;
+        } else if(std::strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+        } else if(std::strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            replaysDir = argv[++i];
+        } else if(fs::is_directory(argv[i])) {
+            for(auto & entry: fs::directory_iterator(argv[i])) {
+                if(entry.path().extension() == ".tmx") {
+                    mapPaths.push_back(entry.path().string());
+                }
+            }
+        } else {
+            mapPaths.push_back(argv[i]);
+        }
+    }
+
+    if(mapPaths.empty()) {
+        for(auto & entry: fs::directory_iterator("res/maps")) {
+            if(entry.path().extension() == ".tmx") {
+                mapPaths.push_back(entry.path().string());
+            }
+        }
+    }
+    std::sort(mapPaths.begin(), mapPaths.end());
+
+    printf("%-16s %-10s %7s %6s %12s %12s %11s %9s %9s %10s\n", "map", "result",
+        "threads", "moves", "expanded", "stored", "states/s", "peak MB", "seconds",
+        "efficiency");
+
+    int failed = 0;
+    int unsaved = 0;
+    double totalSeconds = 0.0;
+
+    for(auto & mapPath: mapPaths) {
+        Solver solver(mapPath, memoryCap);
+        double singleRate = 0.0;
+
+        for(int t = scaling ? 1 : threads; t <= threads; t++) {
+            SolverResult result = solver.solve(t);
+            totalSeconds += result.seconds;
+
+            const char * status = !solver.hasPlayer() ? "empty" :
+                result.solved ? "solved" : result.exhausted ? "unsolvable" : "capped";
+
+            // states/s relative to one thread, per thread
+            if(t == 1) singleRate = result.statesPerSecond;
+            double efficiency = singleRate > 0.0 ? result.statesPerSecond / (singleRate * t) : 0.0;
+
+            printf("%-16s %-10s %7d %6zu %12lld %12lld %11.0f %9.1f %9.3f",
+                fs::path(mapPath).filename().string().c_str(), status, t,
+                result.moves.size(), result.statesExpanded, result.statesStored,
+                result.statesPerSecond, result.peakMemory / 1048576.0, result.seconds);
+            if(singleRate > 0.0) printf(" %9.0f%%", efficiency * 100.0);
+            printf("\n");
+
+            if(verbose && result.solved) {
+                std::string moves;
+                for(SimInput input: result.moves) {
+                    moves += "?UDLR"[input];
+                }
+                printf("  %s\n", moves.c_str());
+            }
+
+            fflush(stdout);
+
+            if(t == threads && !replaysDir.empty() && result.solved &&
+                !saveReplay(mapPath, result.moves, replaysDir)) {
+                unsaved++;
+            }
+
+            if(t == threads && solver.hasPlayer() && !result.solved) failed++;
+            if(!solver.hasPlayer()) break;
+        }
+    }
+
+    printf("%zu maps, %d unsolved, %.3f s total\n", mapPaths.size(), failed, totalSeconds);
+
+    return failed > 0 || unsaved > 0 ? 1 : 0;
+}